@@ -13,6 +13,10 @@
 typedef struct {
     PyObject_HEAD
     Polynomial poly;
+    Py_ssize_t shape;       /* Number of coefficients exported or adopted */
+    int exports;            /* Buffer views of the coefficients */
+    Py_buffer *base;        /* Buffer whose memory holds the coefficients
+                             * (see from_buffer), if any */
 } PyPoly_PolynomialObject;
 
 static PyTypeObject PyPoly_PolynomialType;  // Forward declaration
@@ -20,6 +24,30 @@ static PyTypeObject PyPoly_PolynomialType;  // Forward declaration
 /* Classic macro to check if a PyObject is a Polynomial */
 #define PyPolynomial_Check(op) PyObject_TypeCheck((op), &PyPoly_PolynomialType)
 
+/* Freelist of deallocated Polynomial objects.
+ * Arithmetic expressions create and destroy a lot of temporaries: keeping a
+ * bounded number of dead objects around saves a round trip through the memory
+ * allocator (same idea as the float objects freelist of cPython).
+ * The objects are chained through their (unused) coefficients pointer.
+ * Only exact Polynomial objects are recycled. */
+#ifndef PYPOLY_MAXFREELIST
+#define PYPOLY_MAXFREELIST 256
+#endif
+static PyPoly_PolynomialObject *free_list = NULL;
+static int numfree = 0;
+
+static void
+clear_freelist(void)
+{
+    PyPoly_PolynomialObject *self;
+    while (free_list != NULL) {
+        self = free_list;
+        free_list = (PyPoly_PolynomialObject*)(void*)self->poly.coef;
+        PyPoly_PolynomialType.tp_free((PyObject*)self);
+    }
+    numfree = 0;
+}
+
 /* Create a new Python Polynomial object.
  * If a pointer to a Polynomial is given as parameter, the pointed Polynomial
  * will be copied into the PyObject and the "deg" parameter will be ignored.
@@ -31,7 +59,14 @@ static PyPoly_PolynomialObject*
 new_poly_st(PyTypeObject *subtype, int deg, Polynomial *P)
 {
     PyPoly_PolynomialObject *self;
-    self = (PyPoly_PolynomialObject *) (subtype->tp_alloc(subtype, 0));
+    if (subtype == &PyPoly_PolynomialType && free_list != NULL) {
+        self = free_list;
+        free_list = (PyPoly_PolynomialObject*)(void*)self->poly.coef;
+        --numfree;
+        (void)PyObject_INIT(self, subtype);
+    } else {
+        self = (PyPoly_PolynomialObject *) (subtype->tp_alloc(subtype, 0));
+    }
     if (self != NULL) {
         if (P == NULL) {
             if(!poly_init(&(self->poly), deg)) {
@@ -41,6 +76,8 @@ new_poly_st(PyTypeObject *subtype, int deg, Polynomial *P)
         } else {
             self->poly = *P;
         }
+        self->exports = 0;
+        self->base = NULL;
     }
     return self;
 }
@@ -53,6 +90,27 @@ if ((p = (PyObject*)NewPoly(0, &P)) == NULL) {      \
 }                                                   \
 return p;
 
+/* The Polynomial of a Polynomial object "op". While its coefficients are
+ * exported, or adopted from a buffer, they may be updated from outside (see
+ * poly_pin): the degree is recomputed from the shared ones before each use.
+ * Once adopted coefficients were moved (see poly_borrow), the buffer is
+ * released. */
+static inline Polynomial*
+pypoly_poly(PyPoly_PolynomialObject *self)
+{
+    if (self->base != NULL && self->poly.coef != self->base->buf) {
+        PyBuffer_Release(self->base);
+        PyMem_Free(self->base);
+        self->base = NULL;
+        poly_unpin(&(self->poly));
+    }
+    if (self->exports > 0 || self->base != NULL) {
+        poly_sync(&(self->poly), (int)self->shape);
+    }
+    return &(self->poly);
+}
+#define PyPoly_Poly(op)     pypoly_poly((PyPoly_PolynomialObject*)(op))
+
 /* Polynomial extraction helpers.
  * Those functions deal with the problem of getting a Polynomial object out
  * of an arbitrary PyObject.
@@ -126,12 +184,35 @@ extract_poly(PyObject *obj, Polynomial *P)
 
 #define ExtractOrBorrowPoly(obj, P, status)             \
     if (PyPolynomial_Check(obj)) {                      \
-        P = ((PyPoly_PolynomialObject*)obj)->poly;      \
+        P = *PyPoly_Poly(obj);                          \
         status = EXTRACT_BORROWED;                      \
     } else {                                            \
         status = extract_poly(obj, &P);                 \
     }
 
+/* Store the values of the numbers items[0], ..., items[n - 1] to coef.
+ * Floats and complex numbers are read directly, other numbers go through
+ * PyComplex_AsCComplex. Returns 0 with an exception set on failure. */
+static int
+complex_values(PyObject **items, Py_ssize_t n, Complex *coef)
+{
+    Py_ssize_t i;
+    for (i = 0; i < n; ++i) {
+        if (PyFloat_CheckExact(items[i])) {
+            coef[i].real = PyFloat_AS_DOUBLE(items[i]);
+            coef[i].imag = 0.;
+        } else if (PyComplex_CheckExact(items[i])) {
+            coef[i] = ((PyComplexObject*)items[i])->cval;
+        } else {
+            coef[i] = PyComplex_AsCComplex(items[i]);
+            if (coef[i].real == -1.0 && PyErr_Occurred()) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
 /**
  * PyObject API implementation
  */
@@ -147,16 +228,11 @@ PyPoly_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
     int size = PyTuple_GET_SIZE(args);
     self = new_poly_st(subtype, size - 1, NULL);
     if (self != NULL) {
-        Py_complex c;
-        int i;
-        for (i = 0; i < size; ++i) {
-            c = PyComplex_AsCComplex(PyTuple_GET_ITEM(args, i));
-            if (c.real == -1.0 && PyErr_Occurred()) {
-                Py_DECREF(self);
-                return NULL;
-            }
-            poly_set_coef(&(self->poly), i, c);
+        if (!complex_values(PySequence_Fast_ITEMS(args), size, self->poly.coef)) {
+            Py_DECREF(self);
+            return NULL;
         }
+        poly_normalize(&(self->poly));
     }
     return (PyObject*)self;
 }
@@ -165,6 +241,17 @@ static void
 PyPoly_dealloc(PyPoly_PolynomialObject *self)
 {
     poly_free(&(self->poly));
+    if (self->base != NULL) {
+        PyBuffer_Release(self->base);
+        PyMem_Free(self->base);
+        self->base = NULL;
+    }
+    if (Py_TYPE(self) == &PyPoly_PolynomialType && numfree < PYPOLY_MAXFREELIST) {
+        self->poly.coef = (Complex*)(void*)free_list;
+        free_list = self;
+        ++numfree;
+        return;
+    }
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
@@ -172,7 +259,7 @@ static PyObject*
 PyPoly_copy(PyPoly_PolynomialObject *self)
 {
     Polynomial P;
-    if (!poly_copy(&(self->poly), &P)) {
+    if (!poly_copy(PyPoly_Poly(self), &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
@@ -181,7 +268,7 @@ PyPoly_copy(PyPoly_PolynomialObject *self)
 static PyObject*
 PyPoly_repr(PyPoly_PolynomialObject *self)
 {
-    char* str = poly_to_string(&(self->poly));
+    char* str = poly_to_string(PyPoly_Poly(self));
     PyObject* ret;
 #if PY_VERSION_HEX >= 0x03030000
     ret = PyUnicode_FromKindAndData(PyUnicode_1BYTE_KIND, str, strlen(str));
@@ -288,7 +375,7 @@ PyPoly_div(PyObject *self, PyObject *other)
     }
     c = _Py_c_quot(COne, c);
     Polynomial P;
-    if(!poly_scal_multiply(&(((PyPoly_PolynomialObject*)self)->poly), c, &P)) {
+    if(!poly_scal_multiply(PyPoly_Poly(self), c, &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
@@ -298,32 +385,335 @@ static PyObject*
 PyPoly_neg(PyPoly_PolynomialObject *self)
 {
     Polynomial P;
-    if (!poly_neg(&(self->poly), &P)) {
+    if (!poly_neg(PyPoly_Poly(self), &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
 }
 
+/* P(Q), or P(Q) mod M if "mod" is not None */
+static PyObject*
+pypoly_compose(PyPoly_PolynomialObject *self, PyObject *other, PyObject *mod)
+{
+    int Q_status, M_status = EXTRACT_BORROWED, res;
+    Polynomial Q, M, R;
+    ExtractOrBorrowPoly(other, Q, Q_status)
+    if (mod != Py_None) {
+        ExtractOrBorrowPoly(mod, M, M_status)
+    }
+    if (PolyExtractionFailure(Q_status) || PolyExtractionFailure(M_status)) {
+        if (Q_status == EXTRACT_CREATED) poly_free(&Q);
+        if (M_status == EXTRACT_CREATED) poly_free(&M);
+        if (Q_status == EXTRACT_ERRTYPE || M_status == EXTRACT_ERRTYPE) {
+            PyErr_SetString(PyExc_TypeError, "Polynomial or number expected");
+            return NULL;
+        }
+        return PyErr_NoMemory();
+    }
+    if (mod == Py_None) {
+        res = poly_compose(PyPoly_Poly(self), &Q, &R);
+    } else {
+        res = poly_compose_mod(PyPoly_Poly(self), &Q, &M, &R);
+    }
+    if (Q_status == EXTRACT_CREATED) poly_free(&Q);
+    if (mod != Py_None && M_status == EXTRACT_CREATED) poly_free(&M);
+    if (res == -1) {
+        PyErr_SetString(PyExc_ZeroDivisionError,
+                        "Polynomial composition modulo zero is undefined");
+        return NULL;
+    } else if (!res) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+PyPoly_compose(PyPoly_PolynomialObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"other", "mod", NULL};
+    PyObject *other, *mod = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O:compose", kwlist,
+                                     &other, &mod)) {
+        return NULL;
+    }
+    return pypoly_compose(self, other, mod);
+}
+
+static PyObject*
+PyPoly_shift(PyPoly_PolynomialObject *self, PyObject *args)
+{
+    Py_complex a;
+    Polynomial R;
+    if (!PyArg_ParseTuple(args, "D:shift", &a)) {
+        return NULL;
+    }
+    if (!poly_shift(PyPoly_Poly(self), a, &R)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+PyPoly_scale(PyPoly_PolynomialObject *self, PyObject *args)
+{
+    Py_complex a;
+    Polynomial R;
+    if (!PyArg_ParseTuple(args, "D:scale", &a)) {
+        return NULL;
+    }
+    if (!poly_scale(PyPoly_Poly(self), a, &R)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+/* Get a C contiguous buffer of float64 or complex128 values (as produced by
+ * array.array('d'), numpy.ndarray.tobytes()...) from obj into *view, with
+ * the additional buffer request "flags".
+ * If n >= 0, the buffer must hold n values and raw byte buffers are
+ * interpreted according to their size, otherwise raw bytes are read as
+ * complex128 (the format of the bytearrays this module returns).
+ * The number of values is stored in *count, and *is_complex tells their type.
+ * Returns 0 with an exception set on failure. */
+static int
+get_values_buffer(PyObject *obj, Py_buffer *view, int flags, Py_ssize_t n,
+                  Py_ssize_t *count, int *is_complex)
+{
+    const char *format;
+    Py_ssize_t m;
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | flags) == -1) {
+        return 0;
+    }
+    *is_complex = -1;
+    format = (view->format == NULL) ? "B" : view->format;
+    if (strchr("@=<", format[0]) != NULL) {
+        ++format;
+    }
+    if (strcmp(format, "d") == 0) {
+        *is_complex = 0;
+    } else if (strcmp(format, "Zd") == 0) {
+        *is_complex = 1;
+    } else if (strcmp(format, "B") != 0 && strcmp(format, "b") != 0
+               && strcmp(format, "c") != 0) {
+        PyErr_Format(PyExc_TypeError,
+                     "Buffer must hold float64 or complex128, not '%s'",
+                     view->format);
+        PyBuffer_Release(view);
+        return 0;
+    }
+    if (n >= 0) {
+        if (*is_complex != 0 && view->len == n * (Py_ssize_t)sizeof(Complex)) {
+            *is_complex = 1;
+        } else if (*is_complex != 1 && view->len == n * (Py_ssize_t)sizeof(double)) {
+            *is_complex = 0;
+        } else {
+            PyErr_Format(PyExc_ValueError,
+                         "Buffer size does not match %zd values", n);
+            PyBuffer_Release(view);
+            return 0;
+        }
+        m = n;
+    } else {
+        *is_complex = (*is_complex != 0);
+        m = view->len / (*is_complex ? sizeof(Complex) : sizeof(double));
+        if (m * (Py_ssize_t)(*is_complex ? sizeof(Complex) : sizeof(double)) != view->len) {
+            PyErr_SetString(PyExc_ValueError,
+                            "Buffer size is not a multiple of the value size");
+            PyBuffer_Release(view);
+            return 0;
+        }
+    }
+    *count = m;
+    return 1;
+}
+
+/* Copy the m values of a buffer from get_values_buffer to A */
+static void
+copy_values_buffer(Complex *A, Py_buffer *view, Py_ssize_t m, int is_complex)
+{
+    Py_ssize_t i;
+    if (is_complex) {
+        memcpy(A, view->buf, m * sizeof(Complex));
+    } else {
+        for (i = 0; i < m; ++i) {
+            A[i].real = ((double*)view->buf)[i];
+            A[i].imag = 0.;
+        }
+    }
+}
+
+/* Copy the values of a C contiguous buffer of float64 or complex128 to a
+ * new array, to be released with PyMem_Free (see get_values_buffer for n).
+ * The number of values is stored in *count if it is not NULL.
+ * Returns NULL with an exception set on failure. */
+static Complex*
+complex_array_from_buffer(PyObject *obj, Py_ssize_t n, Py_ssize_t *count)
+{
+    Py_buffer view;
+    Py_ssize_t m;
+    Complex *A;
+    int is_complex;
+
+    if (!get_values_buffer(obj, &view, 0, n, &m, &is_complex)) {
+        return NULL;
+    }
+    if ((A = PyMem_Malloc(m * sizeof(Complex) + 1)) == NULL) {
+        PyBuffer_Release(&view);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    copy_values_buffer(A, &view, m, is_complex);
+    PyBuffer_Release(&view);
+    if (count != NULL) {
+        *count = m;
+    }
+    return A;
+}
+
+/* The Polynomial whose coefficients are the values of a float64 or
+ * complex128 buffer. Unless "copy" is true, the memory of an aligned and
+ * writable complex128 buffer is used as is (see poly_borrow) and stays
+ * locked until the Polynomial is freed or grows out of it. */
+static PyObject*
+PyPoly_from_buffer(PyObject *cls, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"buffer", "copy", NULL};
+    PyObject *obj, *copy = Py_False;
+    PyPoly_PolynomialObject *self;
+    Py_buffer *view;
+    Py_ssize_t m;
+    int is_complex, share;
+    (void)cls;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O:from_buffer", kwlist,
+                                     &obj, &copy)
+            ||
+        (share = PyObject_Not(copy)) == -1) {
+        return NULL;
+    }
+    if ((view = PyMem_New(Py_buffer, 1)) == NULL) {
+        return PyErr_NoMemory();
+    }
+    // Sharing needs a writable buffer, fall back to a copy otherwise
+    if (!share || !get_values_buffer(obj, view, PyBUF_WRITABLE, -1, &m, &is_complex)) {
+        PyErr_Clear();
+        share = 0;
+        if (!get_values_buffer(obj, view, 0, -1, &m, &is_complex)) {
+            PyMem_Free(view);
+            return NULL;
+        }
+    }
+    share = share && is_complex && m > 0
+            && (uintptr_t)view->buf % sizeof(double) == 0;
+    if (m > INT_MAX || (self = NewPoly(share ? -1 : m - 1, NULL)) == NULL) {
+        PyBuffer_Release(view);
+        PyMem_Free(view);
+        return (m > INT_MAX) ? PyErr_NoMemory() : NULL;
+    }
+    if (share) {
+        poly_borrow(&(self->poly), (Complex*)view->buf, (int)m);
+        self->base = view;
+        self->shape = m;
+    } else {
+        copy_values_buffer(self->poly.coef, view, m, is_complex);
+        poly_normalize(&(self->poly));
+        PyBuffer_Release(view);
+        PyMem_Free(view);
+    }
+    return (PyObject*)self;
+}
+
+/* The Polynomial whose coefficients are the numbers of an iterable */
+static PyObject*
+PyPoly_from_iterable(PyObject *cls, PyObject *iterable)
+{
+    PyPoly_PolynomialObject *self;
+    PyObject *seq;
+    Py_ssize_t n;
+    (void)cls;
+    // indexing a Polynomial never raises IndexError: it would not end
+    if (PyPolynomial_Check(iterable)) {
+        PyErr_SetString(PyExc_TypeError, "from_iterable() argument must be iterable");
+        return NULL;
+    }
+    // a tuple, since the __complex__ methods of the items may mutate a list
+    if ((seq = PySequence_Tuple(iterable)) == NULL) {
+        return NULL;
+    }
+    n = PyTuple_GET_SIZE(seq);
+    if (n > INT_MAX) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    if ((self = NewPoly(n - 1, NULL)) != NULL) {
+        if (complex_values(PySequence_Fast_ITEMS(seq), n, self->poly.coef)) {
+            poly_normalize(&(self->poly));
+        } else {
+            Py_CLEAR(self);
+        }
+    }
+    Py_DECREF(seq);
+    return (PyObject*)self;
+}
+
+/* P(A) for an n x n matrix A, given as a float64 or complex128 buffer.
+ * The result is a bytearray holding n x n complex128, row major. */
+static PyObject*
+PyPoly_eval_matrix(PyPoly_PolynomialObject *self, PyObject *args)
+{
+    PyObject *obj, *result;
+    Complex *A;
+    int n;
+
+    if (!PyArg_ParseTuple(args, "Oi:eval_matrix", &obj, &n)) {
+        return NULL;
+    }
+    if (n < 0 || n > 46340) {   // n * n must fit in an int
+        PyErr_SetString(PyExc_ValueError, "Invalid matrix dimension");
+        return NULL;
+    }
+    if ((A = complex_array_from_buffer(obj, (Py_ssize_t)n * n, NULL)) == NULL) {
+        return NULL;
+    }
+    result = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)n * n * sizeof(Complex));
+    if (result != NULL
+            &&
+        !poly_eval_matrix(PyPoly_Poly(self), A, n,
+                          (Complex*)(void*)PyByteArray_AS_STRING(result))) {
+        Py_DECREF(result);
+        result = PyErr_NoMemory();
+    }
+    PyMem_Free(A);
+    return result;
+}
+
 static PyObject*
 PyPoly_call(PyPoly_PolynomialObject *self, PyObject *args, PyObject *kwds)
 {
     Py_complex x;
 
-    if (!_PyArg_NoKeywords("__call__()", kwds) || !PyArg_ParseTuple(args, "D", &x)) {
+    if (!_PyArg_NoKeywords("__call__()", kwds)) {
         return NULL;
     }
-    Py_complex y = poly_eval(&(self->poly), x);
+    if (PyTuple_GET_SIZE(args) == 1 && PyPolynomial_Check(PyTuple_GET_ITEM(args, 0))) {
+        return pypoly_compose(self, PyTuple_GET_ITEM(args, 0), Py_None);
+    }
+    if (!PyArg_ParseTuple(args, "D", &x)) {
+        return NULL;
+    }
+    Py_complex y = poly_eval(PyPoly_Poly(self), x);
     if (y.imag == 0) {
         return PyFloat_FromDouble(y.real);
     }
     return PyComplex_FromCComplex(y);
 }
 
-/* Very high exponents are not supported since:
-    - polynomials exponentiation is expensive
-    - exponentiation involve a lot of multiplication and is subject
-      to float rounding errors */
-#define PYPOLY_MAX_EXPONENT 1024
+/* Exponentiation is refused when the coefficients of the result alone
+ * would exceed this budget (in bytes), rather than attempting a huge
+ * allocation. */
+#ifndef PYPOLY_POW_MEMORY_BUDGET
+#define PYPOLY_POW_MEMORY_BUDGET    (1UL << 30)
+#endif
 
 static PyObject*
 PyPoly_pow(PyPoly_PolynomialObject *self, PyObject *pyexp, PyObject *pymod)
@@ -332,13 +722,19 @@ PyPoly_pow(PyPoly_PolynomialObject *self, PyObject *pyexp, PyObject *pymod)
     if (PyErr_Occurred()) {
         Py_RETURN_NOTIMPLEMENTED;
     }
-    if (exponent > PYPOLY_MAX_EXPONENT) {
+    Polynomial *A = PyPoly_Poly(self);
+    int deg = (A->deg > 0) ? A->deg : 0;
+    if (exponent > UINT_MAX
+            || (unsigned long long)deg * exponent + 1
+                > PYPOLY_POW_MEMORY_BUDGET / sizeof(Complex)
+            || (unsigned long long)deg * exponent >= INT_MAX) {
         return PyErr_Format(PyExc_ValueError,
-                            "Polynomial exponentiation with exponents higher"
-                            " than %d is not supported", PYPOLY_MAX_EXPONENT);
+                            "Polynomial exponentiation result would exceed"
+                            " the memory budget of %lu MiB",
+                            (unsigned long)(PYPOLY_POW_MEMORY_BUDGET >> 20));
     }
     Polynomial P;
-    if (!poly_pow(&(self->poly), exponent, &P)) {
+    if (!poly_pow(A, exponent, &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
@@ -352,7 +748,7 @@ PyPoly_derive(PyPoly_PolynomialObject *self, PyObject *other)
         Py_RETURN_NOTIMPLEMENTED;
     }
     Polynomial P;
-    if (!poly_derive(&(self->poly), steps, &P)) {
+    if (!poly_derive(PyPoly_Poly(self), steps, &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
@@ -366,7 +762,7 @@ PyPoly_integrate(PyPoly_PolynomialObject *self, PyObject *other)
         Py_RETURN_NOTIMPLEMENTED;
     }
     Polynomial P;
-    if (!poly_integrate(&(self->poly), steps, &P)) {
+    if (!poly_integrate(PyPoly_Poly(self), steps, &P)) {
         return PyErr_NoMemory();
     }
     ReturnPyPolyOrFree(P)
@@ -421,11 +817,9 @@ PyPoly_divmod(PyObject *self, PyObject *other)
         Py_DECREF(p1);
         return NULL;
     }
-    if ((t = PyTuple_Pack(2, p1, p2)) == NULL) {
-        Py_DECREF(p1);
-        Py_DECREF(p2);
-        return NULL;
-    }
+    t = PyTuple_Pack(2, p1, p2);
+    Py_DECREF(p1);
+    Py_DECREF(p2);
     return t;
 }
 
@@ -474,13 +868,28 @@ PyPoly_compare(PyObject *self, PyObject *other, int opid)
 static PyObject*
 PyPoly_getitem(PyPoly_PolynomialObject *self, Py_ssize_t i)
 {
-    Py_complex coef = Poly_GetCoef(&(self->poly), i);
+    Py_complex coef = Poly_GetCoef(PyPoly_Poly(self), i);
     if (coef.imag == 0) {
         return PyFloat_FromDouble(coef.real);
     }
     return PyComplex_FromCComplex(coef);
 }
 
+/* Buffer views of the coefficients pin them (see poly_pin): while views
+ * exist, the coefficients cannot be moved and the Polynomial cannot grow
+ * past the exported coefficients. Returns 0 with BufferError set if self
+ * cannot reach degree "deg". */
+static int
+pypoly_check_resize(PyPoly_PolynomialObject *self, long long deg)
+{
+    if (self->exports > 0 && deg >= self->shape) {
+        PyErr_SetString(PyExc_BufferError,
+                        "Existing exports of data: object cannot be re-sized");
+        return 0;
+    }
+    return 1;
+}
+
 int
 PyPoly_setitem(PyPoly_PolynomialObject *self, Py_ssize_t i, PyObject *v)
 {
@@ -490,7 +899,12 @@ PyPoly_setitem(PyPoly_PolynomialObject *self, Py_ssize_t i, PyObject *v)
                         "Incorrect argument for item assignment.");
         return -1;
     }
-    if (i > self->poly.deg && !poly_realloc(&(self->poly), i)) {
+    if (!pypoly_check_resize(self, i)) {
+        return -1;
+    }
+    if (!poly_make_writable(PyPoly_Poly(self))
+            ||
+        (i > self->poly.deg && !poly_realloc(&(self->poly), i))) {
         PyErr_SetString(PyExc_MemoryError,
                         "Failed to allocate memory.");
         return -1;
@@ -499,8 +913,100 @@ PyPoly_setitem(PyPoly_PolynomialObject *self, Py_ssize_t i, PyObject *v)
     return 0;
 }
 
+/* Set C to the constant Polynomial whose coefficient is stored in *c */
+static void
+borrow_const(Polynomial *C, Py_complex *c)
+{
+    C->coef = c;
+    C->deg = complex_iszero(*c) ? -1 : 0;
+    C->capacity = 1;
+    C->flags = POLY_BORROWED;
+    C->bloom = Poly_BloomMask(0);
+}
+
+/* Point *P to the Polynomial of obj or, for a number, to C set to a constant
+ * Polynomial whose coefficient is stored in *c, so that no allocation is
+ * involved. */
+static ExtractionStatus
+borrow_poly_or_const(PyObject *obj, Polynomial **P, Polynomial *C, Py_complex *c)
+{
+    ExtractionStatus status;
+    if (PyPolynomial_Check(obj)) {
+        *P = PyPoly_Poly(obj);
+        return EXTRACT_BORROWED;
+    }
+    if ((status = extract_complex(obj, c)) != EXTRACT_CREATED) {
+        return status;
+    }
+    borrow_const(C, c);
+    *P = C;
+    return EXTRACT_BORROWED;
+}
+
 /* Module methods */
 
+/* Borrow the n Polynomial or number arguments of a function into P, with
+ * the storage for constants in C and c (see borrow_poly_or_const) */
+static int
+borrow_poly_args(PyObject *args, const char *name, int n,
+                 Polynomial **P, Polynomial *C, Py_complex *c)
+{
+    int i;
+    if (PyTuple_GET_SIZE(args) != n) {
+        PyErr_Format(PyExc_TypeError, "%s() takes exactly %d arguments (%d given)",
+                     name, n, (int)PyTuple_GET_SIZE(args));
+        return 0;
+    }
+    for (i = 0; i < n; ++i) {
+        switch (borrow_poly_or_const(PyTuple_GET_ITEM(args, i), &P[i], &C[i], &c[i])) {
+            case EXTRACT_BORROWED:
+                break;
+            case EXTRACT_ERRTYPE:
+                PyErr_SetString(PyExc_TypeError, "Polynomial or number expected");
+                return 0;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static PyObject*
+PyPoly_fma(PyObject *self, PyObject *args)
+{
+    Polynomial *P[3], C[3], R;
+    Py_complex c[3];
+    (void)self;
+    if (!borrow_poly_args(args, "fma", 3, P, C, c)) {
+        return NULL;
+    }
+    if (!poly_fma(P[0], P[1], P[2], &R)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+/* Operators never mutate a Polynomial, "P += Q" included, since other
+ * references to P would see it: addmul is the explicit way to update self */
+static PyObject*
+PyPoly_addmul(PyPoly_PolynomialObject *self, PyObject *args)
+{
+    Polynomial *P[2], C[2];
+    Py_complex c[2];
+    if (!borrow_poly_args(args, "addmul", 2, P, C, c)) {
+        return NULL;
+    }
+    if (P[0]->deg != -1 && P[1]->deg != -1
+            &&
+        !pypoly_check_resize(self, (long long)P[0]->deg + P[1]->deg)) {
+        return NULL;
+    }
+    if (!poly_iaddmul(PyPoly_Poly(self), P[0], P[1])) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
 static PyObject*
 PyPoly_gcd(PyObject *self, PyObject *args)
 {
@@ -522,10 +1028,10 @@ PyPoly_gcd(PyObject *self, PyObject *args)
             poly_free(&T);
             Py_RETURN_NOTIMPLEMENTED;
         }
-        if (!poly_gcd(&P, &(((PyPoly_PolynomialObject*)item)->poly), &T)) goto memerror;
+        if (!poly_gcd(&P, PyPoly_Poly(item), &T)) goto memerror;
         poly_free(&P);
-        if (!poly_copy(&T, &P)) goto memerror;
-        poly_free(&T);
+        P = T;
+        poly_init(&T, -1);
     }
     ReturnPyPolyOrFree(P)
 memerror:
@@ -534,114 +1040,2575 @@ memerror:
     return PyErr_NoMemory();
 }
 
-static PyMemberDef PyPoly_members[] = {
-    {"degree", T_INT, offsetof(PyPoly_PolynomialObject, poly) + offsetof(Polynomial, deg),
-     READONLY, "The degree of the Polynomial instance."},
-    { NULL, 0, 0, 0, NULL }
-};
-
-static PyNumberMethods PyPoly_NumberMethods = {
-    (binaryfunc)PyPoly_add,         /* nb_add */
-    (binaryfunc)PyPoly_sub,         /* nb_subtract */
-    (binaryfunc)PyPoly_mult,        /* nb_multiply */
-#if PY_MAJOR_VERSION < 3
-    (binaryfunc)PyPoly_div,         /* nb_divide; */
-#endif
-    (binaryfunc)PyPoly_remain,      /* nb_remainder */
-    (binaryfunc)PyPoly_divmod,      /* nb_divmod */
-    (ternaryfunc)PyPoly_pow,        /* nb_power */
-    (unaryfunc)PyPoly_neg,          /* nb_negative */
-    (unaryfunc)PyPoly_copy,         /* nb_positive */
-    0,                              /* nb_absolute */
-    0,                              /* nb_bool; */
-    0,                              /* nb_invert; */
-    (binaryfunc)PyPoly_integrate,   /* nb_lshift; */
-    (binaryfunc)PyPoly_derive,      /* nb_rshift; */
-    0,                              /* nb_and; */
-    0,                              /* nb_xor; */
-    0,                              /* nb_or; */
-#if PY_MAJOR_VERSION < 3
-    0,                              /* nb_coerce; */
-#endif
-    0,                              /* nb_int; */
-    0,                              /* nb_reserved; */
-    0,                              /* nb_float; */
-#if PY_MAJOR_VERSION < 3
-    0,                              /* nb_oct; */
-    0,                              /* nb_hex; */
-#endif
-    0,                              /* nb_inplace_add; */
-    0,                              /* nb_inplace_subtract; */
-    0,                              /* nb_inplace_multiply; */
-#if PY_MAJOR_VERSION < 3
-    0,                              /* nb_inplace_divide; */
-#endif
-    0,                              /* nb_inplace_remainder; */
-    0,                              /* nb_inplace_power; */
-    0,                              /* nb_inplace_lshift; */
-    0,                              /* nb_inplace_rshift; */
-    0,                              /* nb_inplace_and; */
-    0,                              /* nb_inplace_xor; */
-    0,                              /* nb_inplace_or; */
-    (binaryfunc)PyPoly_floordiv,    /* nb_floor_divide; */
-    (binaryfunc)PyPoly_div,         /* nb_true_divide; */
-    0,                              /* nb_inplace_floor_divide; */
-    0,                              /* nb_inplace_true_divide; */
-    0                               /* nb_index; */
-};
+/* R = w[0] objs[0] + ... + w[n - 1] objs[n - 1], the weights being 1 if w is
+ * NULL, with a single result buffer (see poly_sum_of_products). The objects
+ * are Polynomials or numbers, the numbers being summed up front.
+ * Returns 0 with an exception set on failure. */
+static int
+pypoly_linear_combination(PyObject **objs, Py_complex *w, Py_ssize_t n,
+                          Polynomial *R)
+{
+    PolyTerm *terms;
+    Polynomial C;
+    Py_complex c, constant = CZero;
+    Py_ssize_t i;
+    int k = 0, ret;
+    if (n >= INT_MAX || (terms = PyMem_New(PolyTerm, n + 1)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    for (i = 0; i < n; ++i) {
+        if (PyPolynomial_Check(objs[i])) {
+            terms[k].c = (w == NULL) ? COne : w[i];
+            terms[k].A = PyPoly_Poly(objs[i]);
+            terms[k++].B = NULL;
+            continue;
+        }
+        switch (extract_complex(objs[i], &c)) {
+            case EXTRACT_CREATED:
+                constant = _Py_c_sum(constant, (w == NULL) ? c : _Py_c_prod(w[i], c));
+                break;
+            case EXTRACT_ERRTYPE:
+                PyErr_SetString(PyExc_TypeError, "Polynomial or number expected");
+                /* fall through */
+            default:
+                PyMem_Free(terms);
+                return 0;
+        }
+    }
+    borrow_const(&C, &constant);
+    terms[k].c = COne;
+    terms[k].A = &C;
+    terms[k++].B = NULL;
+    ret = poly_sum_of_products(terms, k, R);
+    PyMem_Free(terms);
+    if (!ret) {
+        PyErr_NoMemory();
+    }
+    return ret;
+}
 
-static PySequenceMethods PyPoly_as_sequence = {
+static PyObject*
+PyPoly_sum(PyObject *self, PyObject *iterable)
+{
+    PyObject *seq;
+    Polynomial R;
+    int ok;
+    (void)self;
+    /* indexing a Polynomial never raises IndexError: it would not end */
+    if (PyPolynomial_Check(iterable)) {
+        PyErr_SetString(PyExc_TypeError, "sum() argument must be iterable");
+        return NULL;
+    }
+    if ((seq = PySequence_Fast(iterable, "sum() argument must be iterable")) == NULL) {
+        return NULL;
+    }
+    ok = pypoly_linear_combination(PySequence_Fast_ITEMS(seq), NULL,
+                                   PySequence_Fast_GET_SIZE(seq), &R);
+    Py_DECREF(seq);
+    if (!ok) {
+        return NULL;
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+PyPoly_linear_combination(PyObject *self, PyObject *args)
+{
+    PyObject *coeffs, *polys, *cseq = NULL, *pseq = NULL;
+    Py_complex *w = NULL;
+    Py_ssize_t i, n;
+    Polynomial R;
+    int ok = 0;
+    (void)self;
+    if (!PyArg_UnpackTuple(args, "linear_combination", 2, 2, &coeffs, &polys)
+            ||
+        (cseq = PySequence_Fast(coeffs, "coefficients must be iterable")) == NULL
+            ||
+        (pseq = PySequence_Fast(polys, "polynomials must be iterable")) == NULL) {
+        goto done;
+    }
+    if ((n = PySequence_Fast_GET_SIZE(cseq)) != PySequence_Fast_GET_SIZE(pseq)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "as many coefficients as polynomials are expected");
+        goto done;
+    }
+    if ((w = PyMem_New(Py_complex, n + 1)) == NULL) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n; ++i) {
+        switch (extract_complex(PySequence_Fast_GET_ITEM(cseq, i), &w[i])) {
+            case EXTRACT_CREATED:
+                break;
+            case EXTRACT_ERRTYPE:
+                PyErr_SetString(PyExc_TypeError, "coefficients must be numbers");
+                /* fall through */
+            default:
+                goto done;
+        }
+    }
+    ok = pypoly_linear_combination(PySequence_Fast_ITEMS(pseq), w, n, &R);
+done:
+    PyMem_Free(w);
+    Py_XDECREF(cseq);
+    Py_XDECREF(pseq);
+    if (!ok) {
+        return NULL;
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+PyPoly_alloc_stats(PyObject *self, PyObject *noargs)
+{
+    PolyAllocStats stats;
+    (void)self;
+    (void)noargs;
+    poly_get_alloc_stats(&stats);
+    return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n}",
+                         "allocs", (Py_ssize_t)stats.allocs,
+                         "frees", (Py_ssize_t)stats.frees,
+                         "pool_hits", (Py_ssize_t)stats.pool_hits,
+                         "system_allocs", (Py_ssize_t)stats.system_allocs,
+                         "system_frees", (Py_ssize_t)stats.system_frees);
+}
+
+static PyObject*
+PyPoly_cpu_features(PyObject *self, PyObject *noargs)
+{
+    unsigned int features = poly_cpu_features();
+    (void)self;
+    (void)noargs;
+    return Py_BuildValue("{s:s,s:N,s:N,s:N,s:N}",
+                         "kernels", poly_kernels_name(),
+                         "avx2", PyBool_FromLong(features & POLY_CPU_AVX2),
+                         "fma", PyBool_FromLong(features & POLY_CPU_FMA),
+                         "avx512f", PyBool_FromLong(features & POLY_CPU_AVX512F),
+                         "avx512vl", PyBool_FromLong(features & POLY_CPU_AVX512VL));
+}
+
+/* Polynomial methods */
+
+static PyObject*
+PyPoly_reserve(PyPoly_PolynomialObject *self, PyObject *args)
+{
+    int capacity;
+    if (!PyArg_ParseTuple(args, "i", &capacity)) {
+        return NULL;
+    }
+    if (capacity < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Polynomial capacity cannot be negative");
+        return NULL;
+    }
+    if (capacity > self->poly.capacity && !pypoly_check_resize(self, INT_MAX)) {
+        return NULL;
+    }
+    if (!poly_reserve(PyPoly_Poly(self), capacity)) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+PyPoly_shrink_to_fit(PyPoly_PolynomialObject *self, PyObject *noargs)
+{
+    (void)noargs;
+    if (!pypoly_check_resize(self, INT_MAX)) {
+        return NULL;
+    }
+    if (!poly_shrink_to_fit(PyPoly_Poly(self))) {
+        return PyErr_NoMemory();
+    }
+    Py_RETURN_NONE;
+}
+
+/* Truncated products */
+
+static int
+convert_mul_algorithm(PyObject *obj, int *algorithm)
+{
+    static const char *names[] = {"auto", "schoolbook", "karatsuba", "fft"};
+    static const int values[] = {POLY_MUL_AUTO, POLY_MUL_SCHOOLBOOK,
+                                 POLY_MUL_KARATSUBA, POLY_MUL_FFT};
+    const char *name;
+    int i;
+#if PY_MAJOR_VERSION >= 3
+    name = PyUnicode_Check(obj) ? PyUnicode_AsUTF8(obj) : NULL;
+#else
+    name = PyString_Check(obj) ? PyString_AsString(obj) : NULL;
+#endif
+    for (i = 0; name != NULL && i < 4; ++i) {
+        if (strcmp(name, names[i]) == 0) {
+            *algorithm = values[i];
+            return 1;
+        }
+    }
+    if (!PyErr_Occurred()) {
+        PyErr_SetString(PyExc_ValueError,
+            "algorithm must be 'auto', 'schoolbook', 'karatsuba' or 'fft'");
+    }
+    return 0;
+}
+
+static PyObject*
+pypoly_mul_band_impl(PyObject *self, PyObject *other, int lo, int hi,
+                     int algorithm)
+{
+    PYPOLY_BINARYFUNC_HEADER
+    Polynomial R;
+    if (!poly_mul_middle(&A, &B, lo, hi, algorithm, &R)) {
+        PYPOLY_BINARYFUNC_FOOTER
+        return PyErr_NoMemory();
+    }
+    PYPOLY_BINARYFUNC_FOOTER
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+pypoly_mul_band(PyObject *self, PyObject *other, int lo, int hi, int algorithm)
+{
+    PyObject *result;
+    if (lo < 0 || hi < 0) {
+        PyErr_SetString(PyExc_ValueError, "Degrees cannot be negative");
+        return NULL;
+    }
+    result = pypoly_mul_band_impl(self, other, lo, hi, algorithm);
+    if (result == Py_NotImplemented) {
+        Py_DECREF(result);
+        PyErr_SetString(PyExc_TypeError,
+                        "Polynomial or number expected");
+        return NULL;
+    }
+    return result;
+}
+
+static PyObject*
+PyPoly_mul_low(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"other", "n", "algorithm", NULL};
+    PyObject *other;
+    int n, algorithm = POLY_MUL_AUTO;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oi|O&:mul_low", kwlist, &other, &n,
+                                     convert_mul_algorithm, &algorithm)) {
+        return NULL;
+    }
+    return pypoly_mul_band(self, other, 0, n, algorithm);
+}
+
+static PyObject*
+PyPoly_mul_high(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"other", "n", "algorithm", NULL};
+    PyObject *other;
+    int n, algorithm = POLY_MUL_AUTO;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oi|O&:mul_high", kwlist, &other, &n,
+                                     convert_mul_algorithm, &algorithm)) {
+        return NULL;
+    }
+    return pypoly_mul_band(self, other, n, INT_MAX, algorithm);
+}
+
+static PyObject*
+PyPoly_mul_middle(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"other", "lo", "hi", "algorithm", NULL};
+    PyObject *other;
+    int lo, hi, algorithm = POLY_MUL_AUTO;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oii|O&:mul_middle", kwlist,
+                                     &other, &lo, &hi,
+                                     convert_mul_algorithm, &algorithm)) {
+        return NULL;
+    }
+    return pypoly_mul_band(self, other, lo, hi, algorithm);
+}
+
+static PyObject* PyPoly_lazy(PyObject *self, PyObject *noargs);  // Forward declaration
+
+static PyMethodDef PyPoly_methods[] = {
+    {"reserve", (PyCFunction)PyPoly_reserve, METH_VARARGS,
+     "Preallocate room for at least n coefficients."},
+    {"shrink_to_fit", (PyCFunction)PyPoly_shrink_to_fit, METH_NOARGS,
+     "Release the memory allocated beyond the degree of the Polynomial."},
+    {"compose", (PyCFunction)(void(*)(void))PyPoly_compose, METH_VARARGS | METH_KEYWORDS,
+     "P.compose(Q[, mod]) -> P(Q), or P(Q) modulo mod.\n"
+     "P(Q) is equivalent to P.compose(Q)."},
+    {"shift", (PyCFunction)PyPoly_shift, METH_VARARGS,
+     "P.shift(a) -> P(X + a), the Taylor expansion of P at a."},
+    {"scale", (PyCFunction)PyPoly_scale, METH_VARARGS,
+     "P.scale(a) -> P(a * X)."},
+    {"eval_matrix", (PyCFunction)PyPoly_eval_matrix, METH_VARARGS,
+     "P.eval_matrix(buffer, n) -> P(A) for the n x n matrix A stored row major\n"
+     "in buffer as float64 or complex128 values.\n"
+     "The result is a bytearray of n x n complex128 values, row major."},
+    {"from_buffer", (PyCFunction)(void(*)(void))PyPoly_from_buffer,
+     METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+     "Polynomial.from_buffer(buffer, copy=False) -> the Polynomial whose\n"
+     "coefficients are the float64 or complex128 values of buffer.\n"
+     "Unless copy is true, the memory of a writable complex128 buffer is\n"
+     "shared: assignments to the Polynomial are visible in the buffer, and\n"
+     "updates of the buffer in the Polynomial, until it grows beyond it."},
+    {"from_iterable", (PyCFunction)PyPoly_from_iterable, METH_O | METH_CLASS,
+     "Polynomial.from_iterable(iterable) -> the Polynomial whose coefficients\n"
+     "are the numbers of iterable."},
+    {"fma", (PyCFunction)PyPoly_fma, METH_VARARGS | METH_STATIC,
+     "Polynomial.fma(A, B, C) -> A * B + C, computed into a single result."},
+    {"addmul", (PyCFunction)PyPoly_addmul, METH_VARARGS,
+     "P.addmul(A, B): P += A * B in place, the product being accumulated\n"
+     "directly into the coefficients of P."},
+    {"lazy", (PyCFunction)PyPoly_lazy, METH_NOARGS,
+     "P.lazy() -> LazyPolynomial(P), for lazily evaluated expressions."},
+    {"mul_low", (PyCFunction)(void(*)(void))PyPoly_mul_low, METH_VARARGS | METH_KEYWORDS,
+     "P.mul_low(Q, n[, algorithm]) -> the terms of degree < n of P * Q.\n"
+     "algorithm is one of 'auto', 'schoolbook', 'karatsuba' or 'fft'."},
+    {"mul_high", (PyCFunction)(void(*)(void))PyPoly_mul_high, METH_VARARGS | METH_KEYWORDS,
+     "P.mul_high(Q, n[, algorithm]) -> the terms of degree >= n of P * Q,\n"
+     "divided by X**n."},
+    {"mul_middle", (PyCFunction)(void(*)(void))PyPoly_mul_middle, METH_VARARGS | METH_KEYWORDS,
+     "P.mul_middle(Q, lo, hi[, algorithm]) -> the terms of degree lo to\n"
+     "hi - 1 of P * Q, divided by X**lo."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+/* Buffer protocol: the coefficients, as a writable array of complex128.
+ * The degree and the filters of the Polynomial are updated when the last
+ * view is released. */
+static int
+PyPoly_getbuffer(PyPoly_PolynomialObject *self, Py_buffer *view, int flags)
+{
+    static Complex empty;
+    static Py_ssize_t stride = sizeof(Complex);
+    (void)PyPoly_Poly(self);    // adopted coefficients may have moved
+    if (self->exports == 0 && self->base == NULL) {
+        if (!poly_pin(&(self->poly))) {
+            PyErr_NoMemory();
+            view->obj = NULL;
+            return -1;
+        }
+        self->shape = self->poly.deg + 1;
+    }
+    view->buf = (self->poly.coef != NULL) ? (void*)self->poly.coef : (void*)&empty;
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->len = self->shape * sizeof(Complex);
+    view->readonly = 0;
+    view->itemsize = sizeof(Complex);
+    view->format = (flags & PyBUF_FORMAT) ? "Zd" : NULL;
+    view->ndim = 1;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? &(self->shape) : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &stride : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    ++self->exports;
+    return 0;
+}
+
+static void
+PyPoly_releasebuffer(PyPoly_PolynomialObject *self, Py_buffer *view)
+{
+    (void)view;
+    if (--self->exports == 0 && self->base == NULL) {
+        // the views may have written beyond the degree, up to their shape
+        self->poly.deg = (int)self->shape - 1;
+        poly_unpin(&(self->poly));
+    }
+}
+
+static PyObject*
+PyPoly_degree(PyPoly_PolynomialObject *self, void *closure)
+{
+    (void)closure;
+    return PyLong_FromLong(PyPoly_Poly(self)->deg);
+}
+
+static PyGetSetDef PyPoly_getset[] = {
+    {"degree", (getter)PyPoly_degree, NULL,
+     "The degree of the Polynomial instance.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* Sentinel */
+};
+
+static PyMemberDef PyPoly_members[] = {
+    {"capacity", T_INT, offsetof(PyPoly_PolynomialObject, poly) + offsetof(Polynomial, capacity),
+     READONLY, "The number of coefficients allocated for the Polynomial instance."},
+    { NULL, 0, 0, 0, NULL }
+};
+
+static PyNumberMethods PyPoly_NumberMethods = {
+    (binaryfunc)PyPoly_add,         /* nb_add */
+    (binaryfunc)PyPoly_sub,         /* nb_subtract */
+    (binaryfunc)PyPoly_mult,        /* nb_multiply */
+#if PY_MAJOR_VERSION < 3
+    (binaryfunc)PyPoly_div,         /* nb_divide; */
+#endif
+    (binaryfunc)PyPoly_remain,      /* nb_remainder */
+    (binaryfunc)PyPoly_divmod,      /* nb_divmod */
+    (ternaryfunc)PyPoly_pow,        /* nb_power */
+    (unaryfunc)PyPoly_neg,          /* nb_negative */
+    (unaryfunc)PyPoly_copy,         /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_bool; */
+    0,                              /* nb_invert; */
+    (binaryfunc)PyPoly_integrate,   /* nb_lshift; */
+    (binaryfunc)PyPoly_derive,      /* nb_rshift; */
+    0,                              /* nb_and; */
+    0,                              /* nb_xor; */
+    0,                              /* nb_or; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_coerce; */
+#endif
+    0,                              /* nb_int; */
+    0,                              /* nb_reserved; */
+    0,                              /* nb_float; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_oct; */
+    0,                              /* nb_hex; */
+#endif
+    0,                              /* nb_inplace_add; */
+    0,                              /* nb_inplace_subtract; */
+    0,                              /* nb_inplace_multiply; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_inplace_divide; */
+#endif
+    0,                              /* nb_inplace_remainder; */
+    0,                              /* nb_inplace_power; */
+    0,                              /* nb_inplace_lshift; */
+    0,                              /* nb_inplace_rshift; */
+    0,                              /* nb_inplace_and; */
+    0,                              /* nb_inplace_xor; */
+    0,                              /* nb_inplace_or; */
+    (binaryfunc)PyPoly_floordiv,    /* nb_floor_divide; */
+    (binaryfunc)PyPoly_div,         /* nb_true_divide; */
+    0,                              /* nb_inplace_floor_divide; */
+    0,                              /* nb_inplace_true_divide; */
+    0                               /* nb_index; */
+};
+
+static PySequenceMethods PyPoly_as_sequence = {
+    0,                                  /* sq_length */
+    0,                                  /* sq_concat */
+    0,                                  /* sq_repeat */
+    (ssizeargfunc)PyPoly_getitem,       /* sq_item */
+    0,                                  /* sq_slice */
+    (ssizeobjargproc)PyPoly_setitem,    /* sq_ass_item */
+    0,                                  /* sq_ass_slice */
+    0,                                  /* sq_contains */
+    0,                                  /* sq_inplace_concat */
+    0                                   /* sq_inplace_repeat */
+};
+
+static PyBufferProcs PyPoly_as_buffer = {
+#if PY_MAJOR_VERSION < 3
+    0,                                  /* bf_getreadbuffer */
+    0,                                  /* bf_getwritebuffer */
+    0,                                  /* bf_getsegcount */
+    0,                                  /* bf_getcharbuffer */
+#endif
+    (getbufferproc)PyPoly_getbuffer,    /* bf_getbuffer */
+    (releasebufferproc)PyPoly_releasebuffer,
+                                        /* bf_releasebuffer */
+};
+
+static PyTypeObject PyPoly_PolynomialType = {
+#if PY_MAJOR_VERSION >= 3
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,
+#endif
+    "Polynomial",                       /* tp_name */
+    sizeof(PyPoly_PolynomialObject),    /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)PyPoly_dealloc,         /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_reserved */
+    (reprfunc)PyPoly_repr,              /* tp_repr */
+    &PyPoly_NumberMethods,              /* tp_as_number */
+    &PyPoly_as_sequence,                /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash  */
+    (ternaryfunc)PyPoly_call,           /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    &PyPoly_as_buffer,                  /* tp_as_buffer */
+#if PY_MAJOR_VERSION < 3
+    Py_TPFLAGS_CHECKTYPES |
+    Py_TPFLAGS_HAVE_RICHCOMPARE |
+    Py_TPFLAGS_HAVE_NEWBUFFER |
+#endif
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "Polynomial objects",               /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    (richcmpfunc)PyPoly_compare,        /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    PyPoly_methods,                     /* tp_methods */
+    PyPoly_members,                     /* tp_members */
+    PyPoly_getset,                      /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    (newfunc)PyPoly_new,                /* tp_new */
+};
+
+/**
+ * PowerSeries objects
+ * A truncated power series P + O(X**prec) is represented by the Polynomial P
+ * of its known coefficients. Polynomials and numbers combine with series as
+ * exact series (of infinite precision).
+ */
+
+typedef struct {
+    PyObject_HEAD
+    Polynomial poly;
+    int prec;
+} PyPoly_PowerSeriesObject;
+
+static PyTypeObject PyPoly_PowerSeriesType;  // Forward declaration
+
+#define PyPowerSeries_Check(op) PyObject_TypeCheck((op), &PyPoly_PowerSeriesType)
+
+#define PYPOLY_EXACT    INT_MAX     /* Precision of polynomials and numbers */
+
+/* Create a new Python PowerSeries object from P, truncated at "prec".
+ * /!\ This will transfer ownership of the coefficients pointer, which are
+ * freed on failure /!\ */
+static PyObject*
+new_series(Polynomial *P, int prec)
+{
+    PyPoly_PowerSeriesObject *self;
+    self = (PyPoly_PowerSeriesObject*)
+        PyPoly_PowerSeriesType.tp_alloc(&PyPoly_PowerSeriesType, 0);
+    if (self == NULL) {
+        poly_free(P);
+        return NULL;
+    }
+    poly_truncate(P, prec);
+    self->poly = *P;
+    self->prec = prec;
+    return (PyObject*)self;
+}
+
+/* Borrow the coefficients and precision of a PowerSeries, otherwise extract
+ * an exact Polynomial from "obj" as ExtractOrBorrowPoly does. */
+static ExtractionStatus
+extract_series(PyObject *obj, Polynomial *P, int *prec)
+{
+    ExtractionStatus status;
+    if (PyPowerSeries_Check(obj)) {
+        *P = ((PyPoly_PowerSeriesObject*)obj)->poly;
+        *prec = ((PyPoly_PowerSeriesObject*)obj)->prec;
+        return EXTRACT_BORROWED;
+    }
+    *prec = PYPOLY_EXACT;
+    ExtractOrBorrowPoly(obj, (*P), status)
+    return status;
+}
+
+/* Same as PYPOLY_BINARYFUNC_HEADER, for PowerSeries.
+ * Constructs: int prec, the precision of the result */
+#define PYSERIES_BINARYFUNC_HEADER                          \
+    int A_status, B_status, A_prec, B_prec, prec;           \
+    Polynomial A, B;                                        \
+    A_status = extract_series(self, &A, &A_prec);           \
+    B_status = extract_series(other, &B, &B_prec);          \
+    if (PolyExtractionFailure(A_status)                     \
+        ||                                                  \
+        PolyExtractionFailure(B_status)) {                  \
+        if (A_status == EXTRACT_CREATED) poly_free(&A);     \
+        if (B_status == EXTRACT_CREATED) poly_free(&B);     \
+        if (A_status == EXTRACT_ERRTYPE                     \
+            ||                                              \
+            B_status == EXTRACT_ERRTYPE) {                  \
+            Py_RETURN_NOTIMPLEMENTED;                       \
+        } else {                                            \
+            return PyErr_NoMemory();                        \
+        }                                                   \
+    }                                                       \
+    prec = (A_prec < B_prec) ? A_prec : B_prec;
+
+static PyObject*
+PySeries_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"value", "prec", NULL};
+    PyObject *value;
+    Polynomial A, P;
+    int prec, A_prec, status, ok;
+    (void)subtype;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oi:PowerSeries", kwlist,
+                                     &value, &prec)) {
+        return NULL;
+    }
+    if (prec < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "PowerSeries precision cannot be negative");
+        return NULL;
+    }
+    status = extract_series(value, &A, &A_prec);
+    if (status == EXTRACT_ERRTYPE) {
+        PyErr_SetString(PyExc_TypeError,
+                        "PowerSeries, Polynomial or number expected");
+        return NULL;
+    } else if (PolyExtractionFailure(status)) {
+        return PyErr_NoMemory();
+    }
+    ok = poly_copy(&A, &P);
+    if (status == EXTRACT_CREATED) poly_free(&A);
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&P, (A_prec < prec) ? A_prec : prec);
+}
+
+static void
+PySeries_dealloc(PyPoly_PowerSeriesObject *self)
+{
+    poly_free(&(self->poly));
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject*
+PySeries_repr(PyPoly_PowerSeriesObject *self)
+{
+    char *str = NULL;
+    char order[32];
+    PyObject *ret;
+    if (self->prec == 0) {
+        strcpy(order, "O(1)");
+    } else if (self->prec == 1) {
+        strcpy(order, "O(X)");
+    } else {
+        PyOS_snprintf(order, sizeof(order), "O(X**%d)", self->prec);
+    }
+    if (self->poly.deg == -1) {
+        return PyUnicode_FromString(order);
+    }
+    if ((str = poly_to_string(&(self->poly))) == NULL) {
+        return PyErr_NoMemory();
+    }
+    ret = PyUnicode_FromFormat("%s + %s", str, order);
+    free(str);
+    return ret;
+}
+
+static PyObject*
+PySeries_add(PyObject *self, PyObject *other)
+{
+    PYSERIES_BINARYFUNC_HEADER
+    Polynomial R;
+    int ok = poly_add(&A, &B, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, prec);
+}
+
+static PyObject*
+PySeries_sub(PyObject *self, PyObject *other)
+{
+    PYSERIES_BINARYFUNC_HEADER
+    Polynomial R;
+    int ok = poly_sub(&A, &B, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, prec);
+}
+
+/* Precision of a product: (X**va A + O(X**pa)) (X**vb B + O(X**pb)) is
+ * known up to O(X**min(pa + vb, pb + va)) */
+static int
+product_precision(Polynomial *A, int A_prec, Polynomial *B, int B_prec)
+{
+    int A_val = poly_valuation(A), B_val = poly_valuation(B);
+    long long a, b;
+    a = (long long)A_prec + (B_val == -1 ? B_prec : B_val);
+    b = (long long)B_prec + (A_val == -1 ? A_prec : A_val);
+    a = (a < b) ? a : b;
+    return (a < PYPOLY_EXACT) ? (int)a : PYPOLY_EXACT;
+}
+
+static PyObject*
+PySeries_mult(PyObject *self, PyObject *other)
+{
+    PYSERIES_BINARYFUNC_HEADER
+    Polynomial R;
+    prec = product_precision(&A, A_prec, &B, B_prec);
+    int ok = poly_mul_low(&A, &B, prec, POLY_MUL_AUTO, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, prec);
+}
+
+static PyObject*
+PySeries_div(PyObject *self, PyObject *other)
+{
+    PYSERIES_BINARYFUNC_HEADER
+    Polynomial I, R;
+    int res = poly_series_inverse(&B, prec, &I);
+    if (res == 1) {
+        prec = product_precision(&A, A_prec, &I, prec);
+        res = poly_mul_low(&A, &I, prec, POLY_MUL_AUTO, &R);
+        poly_free(&I);
+    }
+    PYPOLY_BINARYFUNC_FOOTER
+    if (res == -1) {
+        PyErr_SetString(PyExc_ZeroDivisionError,
+                        "PowerSeries division by a series with a zero"
+                        " constant term");
+        return NULL;
+    } else if (!res) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, prec);
+}
+
+static PyObject*
+PySeries_neg(PyPoly_PowerSeriesObject *self)
+{
+    Polynomial R;
+    if (!poly_neg(&(self->poly), &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, self->prec);
+}
+
+static PyObject*
+PySeries_pos(PyPoly_PowerSeriesObject *self)
+{
+    Polynomial R;
+    if (!poly_copy(&(self->poly), &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, self->prec);
+}
+
+/* Raising X**v (B + O(X**(prec - v))) to the power e gives
+ * X**(v e) (B**e + O(X**(prec - v))) */
+static PyObject*
+PySeries_pow(PyObject *self, PyObject *pyexp, PyObject *pymod)
+{
+    Py_complex e;
+    Polynomial R;
+    double prec;
+    int v, res;
+    PyPoly_PowerSeriesObject *S = (PyPoly_PowerSeriesObject*)self;
+    (void)pymod;
+    if (!PyPowerSeries_Check(self) || extract_complex(pyexp, &e) != EXTRACT_CREATED) {
+        PyErr_Clear();
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    v = poly_valuation(&(S->poly));
+    if (v == -1) {
+        v = S->prec;
+    }
+    prec = S->prec + v * (e.real - 1);
+    if (prec > PYPOLY_EXACT - 1) {
+        prec = PYPOLY_EXACT - 1;
+    }
+    prec = (prec < 0) ? 0 : ceil(prec);
+    res = poly_series_pow(&(S->poly), e, (int)prec, &R);
+    if (res == -1) {
+        PyErr_SetString(PyExc_ValueError,
+                        "PowerSeries with a zero constant term cannot be"
+                        " raised to this power");
+        return NULL;
+    } else if (!res) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, (int)prec);
+}
+
+static PyObject*
+PySeries_compare(PyObject *self, PyObject *other, int opid)
+{
+    PyPoly_PowerSeriesObject *A, *B;
+    int equal;
+    if ((opid != Py_EQ && opid != Py_NE)
+            || !PyPowerSeries_Check(self) || !PyPowerSeries_Check(other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    A = (PyPoly_PowerSeriesObject*)self;
+    B = (PyPoly_PowerSeriesObject*)other;
+    equal = (A->prec == B->prec) && poly_equal(&(A->poly), &(B->poly));
+    if (equal == (opid == Py_EQ)) {
+        Py_RETURN_TRUE;
+    } else {
+        Py_RETURN_FALSE;
+    }
+}
+
+static PyObject*
+PySeries_getitem(PyPoly_PowerSeriesObject *self, Py_ssize_t i)
+{
+    if (i < 0 || i >= self->prec) {
+        PyErr_SetString(PyExc_IndexError,
+                        "PowerSeries coefficient beyond its precision");
+        return NULL;
+    }
+    Py_complex coef = Poly_GetCoef(&(self->poly), i);
+    if (coef.imag == 0) {
+        return PyFloat_FromDouble(coef.real);
+    }
+    return PyComplex_FromCComplex(coef);
+}
+
+static PyObject*
+pyseries_apply(PyPoly_PowerSeriesObject *self,
+               int (*f)(Polynomial*, int, Polynomial*), int prec,
+               PyObject *exc, const char *error)
+{
+    Polynomial R;
+    int res = f(&(self->poly), prec, &R);
+    if (res == -1) {
+        PyErr_SetString(exc, error);
+        return NULL;
+    } else if (!res) {
+        return PyErr_NoMemory();
+    }
+    return new_series(&R, prec);
+}
+
+static PyObject*
+PySeries_inverse(PyPoly_PowerSeriesObject *self, PyObject *noargs)
+{
+    (void)noargs;
+    return pyseries_apply(self, poly_series_inverse, self->prec,
+                          PyExc_ZeroDivisionError,
+                          "PowerSeries with a zero constant term"
+                          " cannot be inverted");
+}
+
+static PyObject*
+PySeries_log(PyPoly_PowerSeriesObject *self, PyObject *noargs)
+{
+    (void)noargs;
+    return pyseries_apply(self, poly_series_log, self->prec,
+                          PyExc_ValueError,
+                          "Logarithm of a PowerSeries with a zero"
+                          " constant term");
+}
+
+static PyObject*
+PySeries_exp(PyPoly_PowerSeriesObject *self, PyObject *noargs)
+{
+    (void)noargs;
+    return pyseries_apply(self, poly_series_exp, self->prec,
+                          PyExc_ValueError, "");
+}
+
+static PyObject*
+PySeries_sqrt(PyPoly_PowerSeriesObject *self, PyObject *noargs)
+{
+    int v = poly_valuation(&(self->poly));
+    (void)noargs;
+    if (v == -1) {
+        v = self->prec;
+    }
+    return pyseries_apply(self, poly_series_sqrt, self->prec - v / 2,
+                          PyExc_ValueError,
+                          "Square root of a PowerSeries of odd valuation");
+}
+
+static PyObject*
+PySeries_polynomial(PyPoly_PowerSeriesObject *self, void *closure)
+{
+    Polynomial P;
+    (void)closure;
+    if (!poly_copy(&(self->poly), &P)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(P)
+}
+
+static PyMethodDef PySeries_methods[] = {
+    {"inverse", (PyCFunction)PySeries_inverse, METH_NOARGS,
+     "Multiplicative inverse, if the constant term is not zero."},
+    {"log", (PyCFunction)PySeries_log, METH_NOARGS,
+     "Logarithm (principal branch), if the constant term is not zero."},
+    {"exp", (PyCFunction)PySeries_exp, METH_NOARGS,
+     "Exponential."},
+    {"sqrt", (PyCFunction)PySeries_sqrt, METH_NOARGS,
+     "Square root (principal branch)."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyMemberDef PySeries_members[] = {
+    {"precision", T_INT, offsetof(PyPoly_PowerSeriesObject, prec),
+     READONLY, "The series is known modulo X**precision."},
+    { NULL, 0, 0, 0, NULL }
+};
+
+static PyGetSetDef PySeries_getset[] = {
+    {"polynomial", (getter)PySeries_polynomial, NULL,
+     "The known coefficients, as a Polynomial.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* Sentinel */
+};
+
+static PyNumberMethods PySeries_NumberMethods = {
+    (binaryfunc)PySeries_add,       /* nb_add */
+    (binaryfunc)PySeries_sub,       /* nb_subtract */
+    (binaryfunc)PySeries_mult,      /* nb_multiply */
+#if PY_MAJOR_VERSION < 3
+    (binaryfunc)PySeries_div,       /* nb_divide; */
+#endif
+    0,                              /* nb_remainder */
+    0,                              /* nb_divmod */
+    (ternaryfunc)PySeries_pow,      /* nb_power */
+    (unaryfunc)PySeries_neg,        /* nb_negative */
+    (unaryfunc)PySeries_pos,        /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_bool; */
+    0,                              /* nb_invert; */
+    0,                              /* nb_lshift; */
+    0,                              /* nb_rshift; */
+    0,                              /* nb_and; */
+    0,                              /* nb_xor; */
+    0,                              /* nb_or; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_coerce; */
+#endif
+    0,                              /* nb_int; */
+    0,                              /* nb_reserved; */
+    0,                              /* nb_float; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_oct; */
+    0,                              /* nb_hex; */
+#endif
+    0,                              /* nb_inplace_add; */
+    0,                              /* nb_inplace_subtract; */
+    0,                              /* nb_inplace_multiply; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_inplace_divide; */
+#endif
+    0,                              /* nb_inplace_remainder; */
+    0,                              /* nb_inplace_power; */
+    0,                              /* nb_inplace_lshift; */
+    0,                              /* nb_inplace_rshift; */
+    0,                              /* nb_inplace_and; */
+    0,                              /* nb_inplace_xor; */
+    0,                              /* nb_inplace_or; */
+    0,                              /* nb_floor_divide; */
+    (binaryfunc)PySeries_div,       /* nb_true_divide; */
+    0,                              /* nb_inplace_floor_divide; */
+    0,                              /* nb_inplace_true_divide; */
+    0                               /* nb_index; */
+};
+
+static PySequenceMethods PySeries_as_sequence = {
+    0,                                  /* sq_length */
+    0,                                  /* sq_concat */
+    0,                                  /* sq_repeat */
+    (ssizeargfunc)PySeries_getitem,     /* sq_item */
+    0,                                  /* sq_slice */
+    0,                                  /* sq_ass_item */
+    0,                                  /* sq_ass_slice */
+    0,                                  /* sq_contains */
+    0,                                  /* sq_inplace_concat */
+    0                                   /* sq_inplace_repeat */
+};
+
+static PyTypeObject PyPoly_PowerSeriesType = {
+#if PY_MAJOR_VERSION >= 3
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,
+#endif
+    "PowerSeries",                      /* tp_name */
+    sizeof(PyPoly_PowerSeriesObject),   /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)PySeries_dealloc,       /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_reserved */
+    (reprfunc)PySeries_repr,            /* tp_repr */
+    &PySeries_NumberMethods,            /* tp_as_number */
+    &PySeries_as_sequence,              /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash  */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+#if PY_MAJOR_VERSION < 3
+    Py_TPFLAGS_CHECKTYPES |
+    Py_TPFLAGS_HAVE_RICHCOMPARE |
+#endif
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "PowerSeries(value, prec): truncated power series value + O(X**prec)",
+                                        /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    (richcmpfunc)PySeries_compare,      /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    PySeries_methods,                   /* tp_methods */
+    PySeries_members,                   /* tp_members */
+    PySeries_getset,                    /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    (newfunc)PySeries_new,              /* tp_new */
+};
+
+/**
+ * ChebyshevSeries objects
+ * The series c[0] T_0 + c[1] T_1 + ... is represented by the Polynomial of
+ * its coefficients, see the Chebyshev series section of polynomials.c.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    Polynomial poly;
+} PyPoly_ChebyshevSeriesObject;
+
+static PyTypeObject PyPoly_ChebyshevSeriesType;  // Forward declaration
+
+#define PyChebyshevSeries_Check(op) PyObject_TypeCheck((op), &PyPoly_ChebyshevSeriesType)
+
+/* Create a new Python ChebyshevSeries object from the coefficients P.
+ * /!\ This will transfer ownership of the coefficients pointer, which are
+ * freed on failure /!\ */
+static PyObject*
+new_cheb(Polynomial *P)
+{
+    PyPoly_ChebyshevSeriesObject *self;
+    self = (PyPoly_ChebyshevSeriesObject*)
+        PyPoly_ChebyshevSeriesType.tp_alloc(&PyPoly_ChebyshevSeriesType, 0);
+    if (self == NULL) {
+        poly_free(P);
+        return NULL;
+    }
+    self->poly = *P;
+    return (PyObject*)self;
+}
+
+/* Borrow the coefficients of a ChebyshevSeries, otherwise extract a constant
+ * from a number (T_0 = 1). Polynomials are refused: the basis would be
+ * ambiguous, conversions are explicit. */
+static ExtractionStatus
+extract_cheb(PyObject *obj, Polynomial *P)
+{
+    if (PyChebyshevSeries_Check(obj)) {
+        *P = ((PyPoly_ChebyshevSeriesObject*)obj)->poly;
+        return EXTRACT_BORROWED;
+    }
+    return extract_poly(obj, P);
+}
+
+/* Same as PYPOLY_BINARYFUNC_HEADER, for ChebyshevSeries */
+#define PYCHEB_BINARYFUNC_HEADER                            \
+    int A_status, B_status;                                 \
+    Polynomial A, B;                                        \
+    A_status = extract_cheb(self, &A);                      \
+    B_status = extract_cheb(other, &B);                     \
+    if (PolyExtractionFailure(A_status)                     \
+        ||                                                  \
+        PolyExtractionFailure(B_status)) {                  \
+        if (A_status == EXTRACT_CREATED) poly_free(&A);     \
+        if (B_status == EXTRACT_CREATED) poly_free(&B);     \
+        if (A_status == EXTRACT_ERRTYPE                     \
+            ||                                              \
+            B_status == EXTRACT_ERRTYPE) {                  \
+            PyErr_Clear();                                  \
+            Py_RETURN_NOTIMPLEMENTED;                       \
+        } else {                                            \
+            return PyErr_NoMemory();                        \
+        }                                                   \
+    }
+
+static PyObject*
+PyCheb_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    Polynomial P;
+    Py_complex c;
+    int i, size = PyTuple_GET_SIZE(args);
+    (void)subtype;
+    if (!_PyArg_NoKeywords("ChebyshevSeries()", kwds)) {
+        return NULL;
+    }
+    if (!poly_init(&P, size - 1)) {
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < size; ++i) {
+        if (extract_complex(PyTuple_GET_ITEM(args, i), &c) != EXTRACT_CREATED) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError,
+                                "ChebyshevSeries coefficients must be numbers");
+            }
+            poly_free(&P);
+            return NULL;
+        }
+        poly_set_coef(&P, i, c);
+    }
+    return new_cheb(&P);
+}
+
+static void
+PyCheb_dealloc(PyPoly_ChebyshevSeriesObject *self)
+{
+    poly_free(&(self->poly));
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject*
+PyCheb_repr(PyPoly_ChebyshevSeriesObject *self)
+{
+    char *str = poly_cheb_to_string(&(self->poly));
+    PyObject *ret;
+    if (str == NULL) {
+        return PyErr_NoMemory();
+    }
+    ret = PyUnicode_FromString(str);
+    free(str);
+    return ret;
+}
+
+static PyObject*
+PyCheb_add(PyObject *self, PyObject *other)
+{
+    PYCHEB_BINARYFUNC_HEADER
+    Polynomial R;
+    int ok = poly_add(&A, &B, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_sub(PyObject *self, PyObject *other)
+{
+    PYCHEB_BINARYFUNC_HEADER
+    Polynomial R;
+    int ok = poly_sub(&A, &B, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_mult(PyObject *self, PyObject *other)
+{
+    PYCHEB_BINARYFUNC_HEADER
+    Polynomial R;
+    int ok = poly_cheb_multiply(&A, &B, &R);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_neg(PyPoly_ChebyshevSeriesObject *self)
+{
+    Polynomial R;
+    if (!poly_neg(&(self->poly), &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_pos(PyPoly_ChebyshevSeriesObject *self)
+{
+    Polynomial R;
+    if (!poly_copy(&(self->poly), &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_compare(PyObject *self, PyObject *other, int opid)
+{
+    int equal;
+    if ((opid != Py_EQ && opid != Py_NE)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PYCHEB_BINARYFUNC_HEADER
+    equal = poly_equal(&A, &B);
+    PYPOLY_BINARYFUNC_FOOTER
+    if (equal == (opid == Py_EQ)) {
+        Py_RETURN_TRUE;
+    } else {
+        Py_RETURN_FALSE;
+    }
+}
+
+static PyObject*
+PyCheb_getitem(PyPoly_ChebyshevSeriesObject *self, Py_ssize_t i)
+{
+    Py_complex coef = Poly_GetCoef(&(self->poly), i);
+    if (coef.imag == 0) {
+        return PyFloat_FromDouble(coef.real);
+    }
+    return PyComplex_FromCComplex(coef);
+}
+
+static PyObject*
+PyCheb_call(PyPoly_ChebyshevSeriesObject *self, PyObject *args, PyObject *kwds)
+{
+    Py_complex x, y;
+    if (!_PyArg_NoKeywords("__call__()", kwds) || !PyArg_ParseTuple(args, "D", &x)) {
+        return NULL;
+    }
+    y = poly_cheb_eval(&(self->poly), x);
+    if (y.imag == 0) {
+        return PyFloat_FromDouble(y.real);
+    }
+    return PyComplex_FromCComplex(y);
+}
+
+/* Values at all the points of a float64 or complex128 buffer, returned as a
+ * bytearray of complex128 */
+static PyObject*
+PyCheb_eval_many(PyPoly_ChebyshevSeriesObject *self, PyObject *obj)
+{
+    PyObject *result;
+    Py_ssize_t m;
+    Complex *x;
+    if ((x = complex_array_from_buffer(obj, -1, &m)) == NULL) {
+        return NULL;
+    }
+    if (m > INT_MAX) {
+        PyMem_Free(x);
+        return PyErr_NoMemory();
+    }
+    result = PyByteArray_FromStringAndSize(NULL, m * sizeof(Complex));
+    if (result != NULL) {
+        poly_cheb_eval_many(&(self->poly), x,
+                            (Complex*)(void*)PyByteArray_AS_STRING(result), (int)m);
+    }
+    PyMem_Free(x);
+    return result;
+}
+
+static PyObject*
+PyCheb_from_polynomial(PyObject *cls, PyObject *obj)
+{
+    int status, ok;
+    Polynomial P, R;
+    (void)cls;
+    ExtractOrBorrowPoly(obj, P, status)
+    if (status == EXTRACT_ERRTYPE) {
+        PyErr_SetString(PyExc_TypeError, "Polynomial or number expected");
+        return NULL;
+    } else if (PolyExtractionFailure(status)) {
+        return PyErr_NoMemory();
+    }
+    ok = poly_cheb_from_poly(&P, &R);
+    if (status == EXTRACT_CREATED) poly_free(&P);
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_cheb(&R);
+}
+
+static PyObject*
+PyCheb_to_polynomial(PyPoly_ChebyshevSeriesObject *self, PyObject *noargs)
+{
+    Polynomial R;
+    (void)noargs;
+    if (!poly_cheb_to_poly(&(self->poly), &R)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyMethodDef PyCheb_methods[] = {
+    {"from_polynomial", (PyCFunction)PyCheb_from_polynomial, METH_O | METH_CLASS,
+     "ChebyshevSeries.from_polynomial(P) -> P in the Chebyshev basis."},
+    {"to_polynomial", (PyCFunction)PyCheb_to_polynomial, METH_NOARGS,
+     "The series in the monomial basis, as a Polynomial."},
+    {"eval_many", (PyCFunction)PyCheb_eval_many, METH_O,
+     "S.eval_many(buffer) -> the values of S at the float64 or complex128\n"
+     "points of buffer, as a bytearray of complex128."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyMemberDef PyCheb_members[] = {
+    {"degree", T_INT, offsetof(PyPoly_ChebyshevSeriesObject, poly) + offsetof(Polynomial, deg),
+     READONLY, "The degree of the ChebyshevSeries instance."},
+    { NULL, 0, 0, 0, NULL }
+};
+
+static PyNumberMethods PyCheb_NumberMethods = {
+    (binaryfunc)PyCheb_add,         /* nb_add */
+    (binaryfunc)PyCheb_sub,         /* nb_subtract */
+    (binaryfunc)PyCheb_mult,        /* nb_multiply */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_divide; */
+#endif
+    0,                              /* nb_remainder */
+    0,                              /* nb_divmod */
+    0,                              /* nb_power */
+    (unaryfunc)PyCheb_neg,          /* nb_negative */
+    (unaryfunc)PyCheb_pos,          /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_bool; */
+    0,                              /* nb_invert; */
+    0,                              /* nb_lshift; */
+    0,                              /* nb_rshift; */
+    0,                              /* nb_and; */
+    0,                              /* nb_xor; */
+    0,                              /* nb_or; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_coerce; */
+#endif
+    0,                              /* nb_int; */
+    0,                              /* nb_reserved; */
+    0,                              /* nb_float; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_oct; */
+    0,                              /* nb_hex; */
+#endif
+    0,                              /* nb_inplace_add; */
+    0,                              /* nb_inplace_subtract; */
+    0,                              /* nb_inplace_multiply; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_inplace_divide; */
+#endif
+    0,                              /* nb_inplace_remainder; */
+    0,                              /* nb_inplace_power; */
+    0,                              /* nb_inplace_lshift; */
+    0,                              /* nb_inplace_rshift; */
+    0,                              /* nb_inplace_and; */
+    0,                              /* nb_inplace_xor; */
+    0,                              /* nb_inplace_or; */
+    0,                              /* nb_floor_divide; */
+    0,                              /* nb_true_divide; */
+    0,                              /* nb_inplace_floor_divide; */
+    0,                              /* nb_inplace_true_divide; */
+    0                               /* nb_index; */
+};
+
+static PySequenceMethods PyCheb_as_sequence = {
+    0,                                  /* sq_length */
+    0,                                  /* sq_concat */
+    0,                                  /* sq_repeat */
+    (ssizeargfunc)PyCheb_getitem,       /* sq_item */
+    0,                                  /* sq_slice */
+    0,                                  /* sq_ass_item */
+    0,                                  /* sq_ass_slice */
+    0,                                  /* sq_contains */
+    0,                                  /* sq_inplace_concat */
+    0                                   /* sq_inplace_repeat */
+};
+
+static PyTypeObject PyPoly_ChebyshevSeriesType = {
+#if PY_MAJOR_VERSION >= 3
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,
+#endif
+    "ChebyshevSeries",                  /* tp_name */
+    sizeof(PyPoly_ChebyshevSeriesObject),
+                                        /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)PyCheb_dealloc,         /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_reserved */
+    (reprfunc)PyCheb_repr,              /* tp_repr */
+    &PyCheb_NumberMethods,              /* tp_as_number */
+    &PyCheb_as_sequence,                /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash  */
+    (ternaryfunc)PyCheb_call,           /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+#if PY_MAJOR_VERSION < 3
+    Py_TPFLAGS_CHECKTYPES |
+    Py_TPFLAGS_HAVE_RICHCOMPARE |
+#endif
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "ChebyshevSeries(c0, c1...): c0 T_0 + c1 T_1 + ..., T_i being the\n"
+    "Chebyshev polynomials of the first kind",
+                                        /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    (richcmpfunc)PyCheb_compare,        /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    PyCheb_methods,                     /* tp_methods */
+    PyCheb_members,                     /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    (newfunc)PyCheb_new,                /* tp_new */
+};
+
+/**
+ * LazyPolynomial objects
+ * Opt-in lazy evaluation: the operators on LazyPolynomial objects build an
+ * expression DAG, which is only evaluated on demand (repr, indexing, calls,
+ * degree, comparisons or evaluate()).
+ * Sums, differences and scalings are flattened into a sum of products
+ * c * A * B over the operands of the products, accumulated into a single
+ * buffer by poly_sum_of_products: partial sums are never materialized, and
+ * neither are products by monomials or short operands. Operands of products
+ * and powers are evaluated first. Every node keeps its value, so that a
+ * shared subexpression is evaluated once.
+ */
+
+typedef enum {
+    LAZY_LEAF,      /* A Polynomial, the value of the node */
+    LAZY_ADD,       /* left + right */
+    LAZY_SUB,       /* left - right */
+    LAZY_MUL,       /* left * right */
+    LAZY_SCALE,     /* c * left */
+    LAZY_POW        /* left ** right, right being an int */
+} LazyOperator;
+
+typedef struct PyPoly_LazyObject {
+    PyObject_HEAD
+    LazyOperator op;
+    struct PyPoly_LazyObject *left;
+    PyObject *right;
+    Complex c;
+    PyPoly_PolynomialObject *value;     /* NULL until evaluated */
+    struct PyPoly_LazyObject *next;     /* Deallocation queue */
+} PyPoly_LazyObject;
+
+static PyTypeObject PyPoly_LazyPolynomialType;  // Forward declaration
+
+#define PyLazyPolynomial_Check(op) PyObject_TypeCheck((op), &PyPoly_LazyPolynomialType)
+
+static PyPoly_LazyObject*
+lazy_node(LazyOperator op, PyPoly_LazyObject *left, PyObject *right, Complex c)
+{
+    PyPoly_LazyObject *self;
+    self = (PyPoly_LazyObject*)
+        PyPoly_LazyPolynomialType.tp_alloc(&PyPoly_LazyPolynomialType, 0);
+    if (self != NULL) {
+        self->op = op;
+        Py_XINCREF(left);
+        self->left = left;
+        Py_XINCREF(right);
+        self->right = right;
+        self->c = c;
+        self->value = NULL;
+    }
+    return self;
+}
+
+/* New reference to obj as a LazyPolynomial: obj itself, or a leaf holding a
+ * (copy-on-write) copy of a Polynomial or a constant Polynomial.
+ * Returns NULL with no exception set if obj has an unsupported type. */
+static PyPoly_LazyObject*
+lazy_operand(PyObject *obj)
+{
+    PyPoly_LazyObject *self;
+    PyPoly_PolynomialObject *value;
+    Polynomial P;
+    if (PyLazyPolynomial_Check(obj)) {
+        Py_INCREF(obj);
+        return (PyPoly_LazyObject*)obj;
+    }
+    if (PyPolynomial_Check(obj)) {
+        value = (PyPoly_PolynomialObject*)PyPoly_copy((PyPoly_PolynomialObject*)obj);
+    } else {
+        switch (extract_poly(obj, &P)) {
+        case EXTRACT_CREATED:
+            if ((value = NewPoly(0, &P)) == NULL) {
+                poly_free(&P);
+            }
+            break;
+        case EXTRACT_ERRTYPE:
+            return NULL;
+        case EXTRACT_ERRMEM:
+            return (PyPoly_LazyObject*)PyErr_NoMemory();
+        default:
+            return NULL;
+        }
+    }
+    if (value == NULL) {
+        return NULL;
+    }
+    if ((self = lazy_node(LAZY_LEAF, NULL, NULL, CZero)) == NULL) {
+        Py_DECREF(value);
+        return NULL;
+    }
+    self->value = value;
+    return self;
+}
+
+/* Make room for one more item in the PyMem array *items */
+static int
+lazy_reserve(void **items, int n, int *capacity, size_t size)
+{
+    void *p;
+    if (n < *capacity) {
+        return 1;
+    }
+    if ((p = PyMem_Realloc(*items, 2 * (*capacity + 4) * size)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    *items = p;
+    *capacity = 2 * (*capacity + 4);
+    return 1;
+}
+
+static PyPoly_PolynomialObject* lazy_evaluate(PyPoly_LazyObject *self);
+
+/* The value of a factor of a product, the scalings being moved to *s */
+static PyPoly_PolynomialObject*
+lazy_factor(PyPoly_LazyObject *node, Complex *s)
+{
+    while (node->value == NULL && node->op == LAZY_SCALE) {
+        *s = _Py_c_prod(*s, node->c);
+        node = node->left;
+    }
+    return lazy_evaluate(node);
+}
+
+typedef struct {
+    PyPoly_LazyObject *node;
+    Complex s;
+} LazyStackItem;
+
+/* Flatten the sums, differences and scalings below root into a list of
+ * terms (with an explicit stack: long sums are deep trees), and compute them
+ * into R. Returns 0 with an exception set on failure. */
+static int
+lazy_sum_of_products(PyPoly_LazyObject *root, Polynomial *R)
+{
+    LazyStackItem *stack = NULL, item;
+    PolyTerm *terms = NULL;
+    PyPoly_PolynomialObject *A, *B;
+    int nstack = 0, stack_capacity = 0, nterms = 0, terms_capacity = 0, ok = 0;
+    stack = PyMem_Malloc(sizeof(LazyStackItem));
+    if (stack == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    stack_capacity = 1;
+    stack[nstack].node = root;
+    stack[nstack++].s = COne;
+#define LAZY_PUSH(n, scale)                                                 \
+    if (!lazy_reserve((void**)&stack, nstack, &stack_capacity, sizeof(LazyStackItem))) \
+        goto done;                                                          \
+    stack[nstack].node = (n);                                               \
+    stack[nstack++].s = (scale);
+    while (nstack > 0) {
+        item = stack[--nstack];
+        B = NULL;
+        if (item.node->value != NULL || item.node->op == LAZY_POW) {
+            A = lazy_evaluate(item.node);
+        } else if (item.node->op == LAZY_MUL) {
+            A = lazy_factor(item.node->left, &item.s);
+            B = (A == NULL) ? NULL
+                : lazy_factor((PyPoly_LazyObject*)item.node->right, &item.s);
+            if (B == NULL) {
+                goto done;
+            }
+        } else {
+            // Left operand on top of the stack: the terms are summed in order
+            if (item.node->op == LAZY_SCALE) {
+                LAZY_PUSH(item.node->left, _Py_c_prod(item.s, item.node->c))
+            } else {
+                LAZY_PUSH((PyPoly_LazyObject*)item.node->right,
+                          (item.node->op == LAZY_SUB) ? _Py_c_neg(item.s) : item.s)
+                LAZY_PUSH(item.node->left, item.s)
+            }
+            continue;
+        }
+        if (A == NULL
+                ||
+            !lazy_reserve((void**)&terms, nterms, &terms_capacity, sizeof(PolyTerm))) {
+            goto done;
+        }
+        terms[nterms].c = item.s;
+        terms[nterms].A = PyPoly_Poly(A);
+        terms[nterms++].B = (B == NULL) ? NULL : PyPoly_Poly(B);
+    }
+#undef LAZY_PUSH
+    if (!poly_sum_of_products(terms, nterms, R)) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    ok = 1;
+done:
+    PyMem_Free(stack);
+    PyMem_Free(terms);
+    return ok;
+}
+
+/* Borrowed reference to the value of the expression, evaluated if needed */
+static PyPoly_PolynomialObject*
+lazy_evaluate(PyPoly_LazyObject *self)
+{
+    Polynomial R;
+    PyPoly_PolynomialObject *base;
+    if (self->value != NULL) {
+        return self->value;
+    }
+    if (Py_EnterRecursiveCall(" while evaluating a LazyPolynomial")) {
+        return NULL;
+    }
+    if (self->op == LAZY_POW) {
+        if ((base = lazy_evaluate(self->left)) != NULL) {
+            self->value = (PyPoly_PolynomialObject*)PyPoly_pow(base, self->right, Py_None);
+        }
+    } else if (lazy_sum_of_products(self, &R)) {
+        if ((self->value = NewPoly(0, &R)) == NULL) {
+            poly_free(&R);
+        }
+    }
+    Py_LeaveRecursiveCall();
+    return self->value;
+}
+
+static PyObject*
+LazyPoly_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    PyObject *obj;
+    PyPoly_LazyObject *self;
+    (void)subtype;
+    if (!_PyArg_NoKeywords("LazyPolynomial()", kwds)
+            ||
+        !PyArg_UnpackTuple(args, "LazyPolynomial", 1, 1, &obj)) {
+        return NULL;
+    }
+    if ((self = lazy_operand(obj)) == NULL && !PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "Polynomial or number expected");
+    }
+    return (PyObject*)self;
+}
+
+/* Freeing a node can free a long chain of operands (e.g. the nodes of a long
+ * sum), so the deallocation is iterative: the nodes released meanwhile are
+ * queued (same idea as the "trashcan" of cPython). */
+static PyPoly_LazyObject *lazy_dealloc_queue = NULL;
+static int lazy_dealloc_running = 0;
+
+static void
+LazyPoly_dealloc(PyPoly_LazyObject *self)
+{
+    if (lazy_dealloc_running) {
+        self->next = lazy_dealloc_queue;
+        lazy_dealloc_queue = self;
+        return;
+    }
+    lazy_dealloc_running = 1;
+    while (self != NULL) {
+        Py_XDECREF(self->left);
+        Py_XDECREF(self->right);
+        Py_XDECREF(self->value);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+        if ((self = lazy_dealloc_queue) != NULL) {
+            lazy_dealloc_queue = self->next;
+        }
+    }
+    lazy_dealloc_running = 0;
+}
+
+static PyObject*
+lazy_binary(PyObject *self, PyObject *other, LazyOperator op)
+{
+    PyPoly_LazyObject *left, *right, *node;
+    if ((left = lazy_operand(self)) == NULL) {
+        if (PyErr_Occurred()) return NULL;
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if ((right = lazy_operand(other)) == NULL) {
+        Py_DECREF(left);
+        if (PyErr_Occurred()) return NULL;
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    node = lazy_node(op, left, (PyObject*)right, CZero);
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return (PyObject*)node;
+}
+
+static PyObject*
+lazy_scale(PyObject *obj, Complex c)
+{
+    PyPoly_LazyObject *operand, *node;
+    if ((operand = lazy_operand(obj)) == NULL) {
+        if (PyErr_Occurred()) return NULL;
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    node = lazy_node(LAZY_SCALE, operand, NULL, c);
+    Py_DECREF(operand);
+    return (PyObject*)node;
+}
+
+static PyObject*
+LazyPoly_add(PyObject *self, PyObject *other)
+{
+    return lazy_binary(self, other, LAZY_ADD);
+}
+
+static PyObject*
+LazyPoly_sub(PyObject *self, PyObject *other)
+{
+    return lazy_binary(self, other, LAZY_SUB);
+}
+
+/* Products by numbers are scalings, which are folded into the terms */
+static PyObject*
+LazyPoly_mult(PyObject *self, PyObject *other)
+{
+    Py_complex c;
+    ExtractionStatus status;
+    if ((status = extract_complex(other, &c)) == EXTRACT_CREATED) {
+        return lazy_scale(self, c);
+    } else if (status == EXTRACT_ERR) {
+        return NULL;
+    }
+    if ((status = extract_complex(self, &c)) == EXTRACT_CREATED) {
+        return lazy_scale(other, c);
+    } else if (status == EXTRACT_ERR) {
+        return NULL;
+    }
+    return lazy_binary(self, other, LAZY_MUL);
+}
+
+static PyObject*
+LazyPoly_div(PyObject *self, PyObject *other)
+{
+    Py_complex c;
+    if (!PyLazyPolynomial_Check(self)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    switch (extract_complex(other, &c)) {
+    case EXTRACT_CREATED:
+        break;
+    case EXTRACT_ERR:
+        return NULL;
+    default:
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (c.real == 0. && c.imag == 0.) {
+        PyErr_SetString(PyExc_ZeroDivisionError,
+                        "Cannot divide Polynomial by zero");
+        return NULL;
+    }
+    return lazy_scale(self, _Py_c_quot(COne, c));
+}
+
+static PyObject*
+LazyPoly_neg(PyPoly_LazyObject *self)
+{
+    Complex c = {-1., 0.};
+    return lazy_scale((PyObject*)self, c);
+}
+
+static PyObject*
+LazyPoly_pos(PyPoly_LazyObject *self)
+{
+    Py_INCREF(self);
+    return (PyObject*)self;
+}
+
+static PyObject*
+LazyPoly_pow(PyObject *self, PyObject *pyexp, PyObject *pymod)
+{
+    if (!PyLazyPolynomial_Check(self) || pymod != Py_None) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    (void)PyLong_AsUnsignedLong(pyexp);
+    if (PyErr_Occurred()) {
+        PyErr_Clear();
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    return (PyObject*)lazy_node(LAZY_POW, (PyPoly_LazyObject*)self, pyexp, CZero);
+}
+
+static PyObject*
+LazyPoly_compare(PyObject *self, PyObject *other, int opid)
+{
+    if (PyLazyPolynomial_Check(self)
+            &&
+        (self = (PyObject*)lazy_evaluate((PyPoly_LazyObject*)self)) == NULL) {
+        return NULL;
+    }
+    if (PyLazyPolynomial_Check(other)
+            &&
+        (other = (PyObject*)lazy_evaluate((PyPoly_LazyObject*)other)) == NULL) {
+        return NULL;
+    }
+    return PyPoly_compare(self, other, opid);
+}
+
+static PyObject*
+LazyPoly_repr(PyPoly_LazyObject *self)
+{
+    PyPoly_PolynomialObject *value = lazy_evaluate(self);
+    return (value == NULL) ? NULL : PyPoly_repr(value);
+}
+
+static PyObject*
+LazyPoly_getitem(PyPoly_LazyObject *self, Py_ssize_t i)
+{
+    PyPoly_PolynomialObject *value = lazy_evaluate(self);
+    return (value == NULL) ? NULL : PyPoly_getitem(value, i);
+}
+
+static PyObject*
+LazyPoly_call(PyPoly_LazyObject *self, PyObject *args, PyObject *kwds)
+{
+    PyPoly_PolynomialObject *value = lazy_evaluate(self);
+    return (value == NULL) ? NULL : PyPoly_call(value, args, kwds);
+}
+
+static PyObject*
+LazyPoly_evaluate(PyPoly_LazyObject *self, PyObject *noargs)
+{
+    PyPoly_PolynomialObject *value = lazy_evaluate(self);
+    (void)noargs;
+    return (value == NULL) ? NULL : PyPoly_copy(value);
+}
+
+static PyObject*
+LazyPoly_degree(PyPoly_LazyObject *self, void *closure)
+{
+    PyPoly_PolynomialObject *value = lazy_evaluate(self);
+    (void)closure;
+    return (value == NULL) ? NULL : PyLong_FromLong(PyPoly_Poly(value)->deg);
+}
+
+static PyObject*
+PyPoly_lazy(PyObject *self, PyObject *noargs)
+{
+    (void)noargs;
+    return (PyObject*)lazy_operand(self);
+}
+
+static PyMethodDef LazyPoly_methods[] = {
+    {"evaluate", (PyCFunction)LazyPoly_evaluate, METH_NOARGS,
+     "The value of the expression, as a Polynomial."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyGetSetDef LazyPoly_getset[] = {
+    {"degree", (getter)LazyPoly_degree, NULL,
+     "The degree of the value of the expression.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyNumberMethods LazyPoly_NumberMethods = {
+    (binaryfunc)LazyPoly_add,       /* nb_add */
+    (binaryfunc)LazyPoly_sub,       /* nb_subtract */
+    (binaryfunc)LazyPoly_mult,      /* nb_multiply */
+#if PY_MAJOR_VERSION < 3
+    (binaryfunc)LazyPoly_div,       /* nb_divide; */
+#endif
+    0,                              /* nb_remainder */
+    0,                              /* nb_divmod */
+    (ternaryfunc)LazyPoly_pow,      /* nb_power */
+    (unaryfunc)LazyPoly_neg,        /* nb_negative */
+    (unaryfunc)LazyPoly_pos,        /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_bool; */
+    0,                              /* nb_invert; */
+    0,                              /* nb_lshift; */
+    0,                              /* nb_rshift; */
+    0,                              /* nb_and; */
+    0,                              /* nb_xor; */
+    0,                              /* nb_or; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_coerce; */
+#endif
+    0,                              /* nb_int; */
+    0,                              /* nb_reserved; */
+    0,                              /* nb_float; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_oct; */
+    0,                              /* nb_hex; */
+#endif
+    0,                              /* nb_inplace_add; */
+    0,                              /* nb_inplace_subtract; */
+    0,                              /* nb_inplace_multiply; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_inplace_divide; */
+#endif
+    0,                              /* nb_inplace_remainder; */
+    0,                              /* nb_inplace_power; */
+    0,                              /* nb_inplace_lshift; */
+    0,                              /* nb_inplace_rshift; */
+    0,                              /* nb_inplace_and; */
+    0,                              /* nb_inplace_xor; */
+    0,                              /* nb_inplace_or; */
+    0,                              /* nb_floor_divide; */
+    (binaryfunc)LazyPoly_div,       /* nb_true_divide; */
+    0,                              /* nb_inplace_floor_divide; */
+    0,                              /* nb_inplace_true_divide; */
+    0                               /* nb_index; */
+};
+
+static PySequenceMethods LazyPoly_as_sequence = {
     0,                                  /* sq_length */
     0,                                  /* sq_concat */
     0,                                  /* sq_repeat */
-    (ssizeargfunc)PyPoly_getitem,       /* sq_item */
+    (ssizeargfunc)LazyPoly_getitem,     /* sq_item */
+    0,                                  /* sq_slice */
+    0,                                  /* sq_ass_item */
+    0,                                  /* sq_ass_slice */
+    0,                                  /* sq_contains */
+    0,                                  /* sq_inplace_concat */
+    0                                   /* sq_inplace_repeat */
+};
+
+static PyTypeObject PyPoly_LazyPolynomialType = {
+#if PY_MAJOR_VERSION >= 3
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,
+#endif
+    "LazyPolynomial",                   /* tp_name */
+    sizeof(PyPoly_LazyObject),          /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)LazyPoly_dealloc,       /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_reserved */
+    (reprfunc)LazyPoly_repr,            /* tp_repr */
+    &LazyPoly_NumberMethods,            /* tp_as_number */
+    &LazyPoly_as_sequence,              /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash  */
+    (ternaryfunc)LazyPoly_call,         /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+#if PY_MAJOR_VERSION < 3
+    Py_TPFLAGS_CHECKTYPES |
+    Py_TPFLAGS_HAVE_RICHCOMPARE |
+#endif
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "LazyPolynomial(P): P as a lazily evaluated expression.\n"
+    "The operators build an expression, evaluated at once when its value is\n"
+    "needed, without intermediate polynomials for the sums.",
+                                        /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    (richcmpfunc)LazyPoly_compare,      /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    LazyPoly_methods,                   /* tp_methods */
+    0,                                  /* tp_members */
+    LazyPoly_getset,                    /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    (newfunc)LazyPoly_new,              /* tp_new */
+};
+
+/**
+ * PolynomialArray objects
+ * A batch of polynomials stored contiguously, see PolyArray: the operators
+ * work elementwise across the batch in single C loops, instead of creating
+ * one Polynomial object per item. The coefficients are exported through the
+ * buffer protocol as a n x (degree + 1) matrix of complex128, in column
+ * major (Fortran) order. The coefficients array is only moved when an item
+ * of higher degree is assigned, which is refused while views exist.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    PolyArray array;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+    int exports;            /* Buffer views of the coefficients */
+} PyPoly_PolynomialArrayObject;
+
+static PyTypeObject PyPoly_PolynomialArrayType;  // Forward declaration
+
+#define PyPolynomialArray_Check(op) PyObject_TypeCheck((op), &PyPoly_PolynomialArrayType)
+
+/* Create a new Python PolynomialArray object from A.
+ * /!\ This will transfer ownership of the coefficients pointer, which are
+ * freed on failure /!\ */
+static PyObject*
+new_array(PolyArray *A)
+{
+    PyPoly_PolynomialArrayObject *self;
+    self = (PyPoly_PolynomialArrayObject*)
+        PyPoly_PolynomialArrayType.tp_alloc(&PyPoly_PolynomialArrayType, 0);
+    if (self == NULL) {
+        poly_array_free(A);
+        return NULL;
+    }
+    self->array = *A;
+    self->exports = 0;
+    return (PyObject*)self;
+}
+
+/* Point *A and *B to the arrays of a binary operation.
+ * Returns 0 if either operand is not a PolynomialArray, -1 with an exception
+ * set if their lengths differ. */
+static int
+array_operands(PyObject *self, PyObject *other, PolyArray **A, PolyArray **B)
+{
+    if (!PyPolynomialArray_Check(self) || !PyPolynomialArray_Check(other)) {
+        return 0;
+    }
+    *A = &(((PyPoly_PolynomialArrayObject*)self)->array);
+    *B = &(((PyPoly_PolynomialArrayObject*)other)->array);
+    if ((*A)->n != (*B)->n) {
+        PyErr_SetString(PyExc_ValueError,
+                        "PolynomialArray operands must have the same length");
+        return -1;
+    }
+    return 1;
+}
+
+static PyObject*
+PyArray_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
+{
+    PyObject *iterable, *seq, **items;
+    Polynomial *P = NULL, C;
+    Py_complex c;
+    PolyArray A;
+    Py_ssize_t i, n;
+    int deg = -1;
+    (void)subtype;
+    if (!_PyArg_NoKeywords("PolynomialArray()", kwds)
+            ||
+        !PyArg_ParseTuple(args, "O:PolynomialArray", &iterable)) {
+        return NULL;
+    }
+    if (PyPolynomial_Check(iterable)) {
+        PyErr_SetString(PyExc_TypeError, "PolynomialArray() argument must be iterable");
+        return NULL;
+    }
+    if ((seq = PySequence_Fast(iterable, "PolynomialArray() argument must be iterable")) == NULL) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    items = PySequence_Fast_ITEMS(seq);
+    for (i = 0; i < n; ++i) {
+        if (borrow_poly_or_const(items[i], &P, &C, &c) != EXTRACT_BORROWED) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError,
+                                "PolynomialArray items must be Polynomials or numbers");
+            }
+            Py_DECREF(seq);
+            return NULL;
+        }
+        if (P->deg > deg) {
+            deg = P->deg;
+        }
+    }
+    if (n >= INT_MAX || !poly_array_init(&A, (int)n, deg)) {
+        Py_DECREF(seq);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; ++i) {
+        borrow_poly_or_const(items[i], &P, &C, &c);
+        poly_array_set(&A, (int)i, P);
+    }
+    Py_DECREF(seq);
+    return new_array(&A);
+}
+
+static PyObject*
+PyArray_zeros(PyObject *cls, PyObject *args)
+{
+    PolyArray A;
+    int n, deg;
+    (void)cls;
+    if (!PyArg_ParseTuple(args, "ii:zeros", &n, &deg)) {
+        return NULL;
+    }
+    if (n < 0 || deg < -1) {
+        PyErr_SetString(PyExc_ValueError, "Invalid PolynomialArray dimensions");
+        return NULL;
+    }
+    if (!poly_array_init(&A, n, deg)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&A);
+}
+
+static void
+PyArray_dealloc(PyPoly_PolynomialArrayObject *self)
+{
+    poly_array_free(&(self->array));
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static Py_ssize_t
+PyArray_length(PyPoly_PolynomialArrayObject *self)
+{
+    return self->array.n;
+}
+
+static PyObject*
+PyArray_getitem(PyPoly_PolynomialArrayObject *self, Py_ssize_t i)
+{
+    Polynomial P;
+    if (i < 0 || i >= self->array.n) {
+        PyErr_SetString(PyExc_IndexError, "PolynomialArray index out of range");
+        return NULL;
+    }
+    if (!poly_array_get(&(self->array), (int)i, &P)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(P)
+}
+
+static int
+PyArray_setitem(PyPoly_PolynomialArrayObject *self, Py_ssize_t i, PyObject *v)
+{
+    Polynomial *P = NULL, C;
+    Py_complex c;
+    if (i < 0 || i >= self->array.n) {
+        PyErr_SetString(PyExc_IndexError, "PolynomialArray index out of range");
+        return -1;
+    }
+    if (v == NULL || borrow_poly_or_const(v, &P, &C, &c) != EXTRACT_BORROWED) {
+        if (!PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError,
+                            "PolynomialArray items must be Polynomials or numbers");
+        }
+        return -1;
+    }
+    if (P->deg > self->array.deg) {
+        if (self->exports > 0) {
+            PyErr_SetString(PyExc_BufferError,
+                            "Existing exports of data: object cannot be re-sized");
+            return -1;
+        }
+        if (!poly_array_realloc(&(self->array), P->deg)) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    poly_array_set(&(self->array), (int)i, P);
+    return 0;
+}
+
+static PyObject*
+PyArray_repr(PyPoly_PolynomialArrayObject *self)
+{
+    PyObject *list, *ret;
+    if ((list = PySequence_List((PyObject*)self)) == NULL) {
+        return NULL;
+    }
+    ret = PyUnicode_FromFormat("PolynomialArray(%R)", list);
+    Py_DECREF(list);
+    return ret;
+}
+
+static PyObject*
+PyArray_add(PyObject *self, PyObject *other)
+{
+    PolyArray *A, *B, R;
+    int status = array_operands(self, other, &A, &B);
+    if (status == 0) {
+        Py_RETURN_NOTIMPLEMENTED;
+    } else if (status == -1) {
+        return NULL;
+    }
+    if (!poly_array_add(A, B, &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+static PyObject*
+PyArray_sub(PyObject *self, PyObject *other)
+{
+    PolyArray *A, *B, R;
+    int status = array_operands(self, other, &A, &B);
+    if (status == 0) {
+        Py_RETURN_NOTIMPLEMENTED;
+    } else if (status == -1) {
+        return NULL;
+    }
+    if (!poly_array_sub(A, B, &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+/* Elementwise products, or the products of every item by a number */
+static PyObject*
+PyArray_mult(PyObject *self, PyObject *other)
+{
+    PolyArray *A, *B, R;
+    Py_complex c;
+    int ok, status = array_operands(self, other, &A, &B);
+    if (status == -1) {
+        return NULL;
+    } else if (status == 1) {
+        ok = poly_array_multiply(A, B, &R);
+    } else {
+        if (!PyPolynomialArray_Check(self)) {
+            PyObject *tmp = self;
+            self = other;
+            other = tmp;
+        }
+        if (extract_complex(other, &c) != EXTRACT_CREATED) {
+            if (PyErr_Occurred()) {
+                return NULL;
+            }
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+        ok = poly_array_scale(&(((PyPoly_PolynomialArrayObject*)self)->array), c, &R);
+    }
+    if (!ok) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+static PyObject*
+PyArray_divmod(PyObject *self, PyObject *other)
+{
+    PolyArray *A, *B, Q, R;
+    PyObject *q, *r;
+    int ok, status = array_operands(self, other, &A, &B);
+    if (status == 0) {
+        Py_RETURN_NOTIMPLEMENTED;
+    } else if (status == -1) {
+        return NULL;
+    }
+    if ((ok = poly_array_div(A, B, &Q, &R)) == -1) {
+        PyErr_SetString(PyExc_ZeroDivisionError, "Polynomial division by zero");
+        return NULL;
+    } else if (!ok) {
+        return PyErr_NoMemory();
+    }
+    if ((q = new_array(&Q)) == NULL) {
+        poly_array_free(&R);
+        return NULL;
+    }
+    if ((r = new_array(&R)) == NULL) {
+        Py_DECREF(q);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", q, r);
+}
+
+static PyObject*
+PyArray_neg(PyPoly_PolynomialArrayObject *self)
+{
+    Py_complex minus_one = {-1., 0.};
+    PolyArray R;
+    if (!poly_array_scale(&(self->array), minus_one, &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+static PyObject*
+PyArray_pos(PyPoly_PolynomialArrayObject *self)
+{
+    PolyArray R;
+    if (!poly_array_scale(&(self->array), COne, &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+static PyObject*
+PyArray_compare(PyObject *self, PyObject *other, int opid)
+{
+    PolyArray *A, *B;
+    if ((opid != Py_EQ && opid != Py_NE)
+            ||
+        !PyPolynomialArray_Check(self) || !PyPolynomialArray_Check(other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    A = &(((PyPoly_PolynomialArrayObject*)self)->array);
+    B = &(((PyPoly_PolynomialArrayObject*)other)->array);
+    if (poly_array_equal(A, B) == (opid == Py_EQ)) {
+        Py_RETURN_TRUE;
+    } else {
+        Py_RETURN_FALSE;
+    }
+}
+
+static PyObject*
+PyArray_derive(PyPoly_PolynomialArrayObject *self, PyObject *args)
+{
+    PolyArray R;
+    int n = 1;
+    if (!PyArg_ParseTuple(args, "|i:derive", &n)) {
+        return NULL;
+    }
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "Negative derivation order");
+        return NULL;
+    }
+    if (!poly_array_derive(&(self->array), (unsigned int)n, &R)) {
+        return PyErr_NoMemory();
+    }
+    return new_array(&R);
+}
+
+/* The value of each item at the corresponding point of a float64 or
+ * complex128 buffer, returned as a bytearray of complex128 */
+static PyObject*
+PyArray_eval(PyPoly_PolynomialArrayObject *self, PyObject *obj)
+{
+    PyObject *result;
+    Complex *x;
+    if ((x = complex_array_from_buffer(obj, self->array.n, NULL)) == NULL) {
+        return NULL;
+    }
+    result = PyByteArray_FromStringAndSize(NULL, self->array.n * sizeof(Complex));
+    if (result != NULL) {
+        poly_array_eval(&(self->array), x,
+                        (Complex*)(void*)PyByteArray_AS_STRING(result));
+    }
+    PyMem_Free(x);
+    return result;
+}
+
+/* The values of all the items at a single point, as a bytearray of
+ * complex128 */
+static PyObject*
+PyArray_eval_all(PyPoly_PolynomialArrayObject *self, PyObject *args)
+{
+    PyObject *result;
+    Py_complex x;
+    if (!PyArg_ParseTuple(args, "D:eval_all", &x)) {
+        return NULL;
+    }
+    result = PyByteArray_FromStringAndSize(NULL, self->array.n * sizeof(Complex));
+    if (result != NULL) {
+        poly_array_eval_all(&(self->array), x,
+                            (Complex*)(void*)PyByteArray_AS_STRING(result));
+    }
+    return result;
+}
+
+/* Buffer protocol: the items are the rows of the coefficients matrix, which
+ * is only contiguous in column major order. Raw byte views (no shape
+ * requested) are allowed, and read the coefficients in that order. */
+static int
+PyArray_getbuffer(PyPoly_PolynomialArrayObject *self, Py_buffer *view, int flags)
+{
+    static Complex empty;
+    PolyArray *A = &(self->array);
+    int c_contiguous = (A->n <= 1 || A->deg <= 0);
+    if (!c_contiguous
+            &&
+        (((flags & PyBUF_ND) == PyBUF_ND && (flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+            ||
+         (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS)) {
+        PyErr_SetString(PyExc_BufferError,
+                        "PolynomialArray coefficients are not C contiguous");
+        view->obj = NULL;
+        return -1;
+    }
+    self->shape[0] = A->n;
+    self->shape[1] = A->deg + 1;
+    self->strides[0] = sizeof(Complex);
+    self->strides[1] = (Py_ssize_t)A->n * sizeof(Complex);
+    view->buf = (A->coef != NULL) ? (void*)A->coef : (void*)&empty;
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->len = (Py_ssize_t)A->n * (A->deg + 1) * sizeof(Complex);
+    view->readonly = 0;
+    view->itemsize = sizeof(Complex);
+    view->format = (flags & PyBUF_FORMAT) ? "Zd" : NULL;
+    view->ndim = ((flags & PyBUF_ND) == PyBUF_ND) ? 2 : 1;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? self->shape : NULL;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+    ++self->exports;
+    return 0;
+}
+
+static void
+PyArray_releasebuffer(PyPoly_PolynomialArrayObject *self, Py_buffer *view)
+{
+    (void)view;
+    --self->exports;
+}
+
+static PyMethodDef PyArray_methods[] = {
+    {"zeros", (PyCFunction)PyArray_zeros, METH_VARARGS | METH_CLASS,
+     "PolynomialArray.zeros(n, degree) -> n zero polynomials, with room for\n"
+     "the given degree."},
+    {"derive", (PyCFunction)PyArray_derive, METH_VARARGS,
+     "A.derive(n=1) -> the n-th derivatives of the items of A."},
+    {"eval", (PyCFunction)PyArray_eval, METH_O,
+     "A.eval(buffer) -> the values A[i](x[i]) at the float64 or complex128\n"
+     "points x of buffer, as a bytearray of complex128."},
+    {"eval_all", (PyCFunction)PyArray_eval_all, METH_VARARGS,
+     "A.eval_all(x) -> the values A[i](x) of all the items at x, as a\n"
+     "bytearray of complex128."},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyMemberDef PyArray_members[] = {
+    {"degree", T_INT, offsetof(PyPoly_PolynomialArrayObject, array) + offsetof(PolyArray, deg),
+     READONLY, "Bound on the degrees of the items of the PolynomialArray."},
+    { NULL, 0, 0, 0, NULL }
+};
+
+static PyNumberMethods PyArray_NumberMethods = {
+    (binaryfunc)PyArray_add,        /* nb_add */
+    (binaryfunc)PyArray_sub,        /* nb_subtract */
+    (binaryfunc)PyArray_mult,       /* nb_multiply */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_divide; */
+#endif
+    0,                              /* nb_remainder */
+    (binaryfunc)PyArray_divmod,     /* nb_divmod */
+    0,                              /* nb_power */
+    (unaryfunc)PyArray_neg,         /* nb_negative */
+    (unaryfunc)PyArray_pos,         /* nb_positive */
+    0,                              /* nb_absolute */
+    0,                              /* nb_bool; */
+    0,                              /* nb_invert; */
+    0,                              /* nb_lshift; */
+    0,                              /* nb_rshift; */
+    0,                              /* nb_and; */
+    0,                              /* nb_xor; */
+    0,                              /* nb_or; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_coerce; */
+#endif
+    0,                              /* nb_int; */
+    0,                              /* nb_reserved; */
+    0,                              /* nb_float; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_oct; */
+    0,                              /* nb_hex; */
+#endif
+    0,                              /* nb_inplace_add; */
+    0,                              /* nb_inplace_subtract; */
+    0,                              /* nb_inplace_multiply; */
+#if PY_MAJOR_VERSION < 3
+    0,                              /* nb_inplace_divide; */
+#endif
+    0,                              /* nb_inplace_remainder; */
+    0,                              /* nb_inplace_power; */
+    0,                              /* nb_inplace_lshift; */
+    0,                              /* nb_inplace_rshift; */
+    0,                              /* nb_inplace_and; */
+    0,                              /* nb_inplace_xor; */
+    0,                              /* nb_inplace_or; */
+    0,                              /* nb_floor_divide; */
+    0,                              /* nb_true_divide; */
+    0,                              /* nb_inplace_floor_divide; */
+    0,                              /* nb_inplace_true_divide; */
+    0                               /* nb_index; */
+};
+
+static PySequenceMethods PyArray_as_sequence = {
+    (lenfunc)PyArray_length,            /* sq_length */
+    0,                                  /* sq_concat */
+    0,                                  /* sq_repeat */
+    (ssizeargfunc)PyArray_getitem,      /* sq_item */
     0,                                  /* sq_slice */
-    (ssizeobjargproc)PyPoly_setitem,    /* sq_ass_item */
+    (ssizeobjargproc)PyArray_setitem,   /* sq_ass_item */
     0,                                  /* sq_ass_slice */
     0,                                  /* sq_contains */
     0,                                  /* sq_inplace_concat */
     0                                   /* sq_inplace_repeat */
 };
 
-static PyTypeObject PyPoly_PolynomialType = {
+static PyBufferProcs PyArray_as_buffer = {
+#if PY_MAJOR_VERSION < 3
+    0,                                  /* bf_getreadbuffer */
+    0,                                  /* bf_getwritebuffer */
+    0,                                  /* bf_getsegcount */
+    0,                                  /* bf_getcharbuffer */
+#endif
+    (getbufferproc)PyArray_getbuffer,   /* bf_getbuffer */
+    (releasebufferproc)PyArray_releasebuffer,
+                                        /* bf_releasebuffer */
+};
+
+static PyTypeObject PyPoly_PolynomialArrayType = {
 #if PY_MAJOR_VERSION >= 3
     PyVarObject_HEAD_INIT(NULL, 0)
 #else
     PyObject_HEAD_INIT(NULL)
     0,
 #endif
-    "Polynomial",                       /* tp_name */
-    sizeof(PyPoly_PolynomialObject),    /* tp_basicsize */
+    "PolynomialArray",                  /* tp_name */
+    sizeof(PyPoly_PolynomialArrayObject),
+                                        /* tp_basicsize */
     0,                                  /* tp_itemsize */
-    (destructor)PyPoly_dealloc,         /* tp_dealloc */
+    (destructor)PyArray_dealloc,        /* tp_dealloc */
     0,                                  /* tp_print */
     0,                                  /* tp_getattr */
     0,                                  /* tp_setattr */
     0,                                  /* tp_reserved */
-    (reprfunc)PyPoly_repr,              /* tp_repr */
-    &PyPoly_NumberMethods,              /* tp_as_number */
-    &PyPoly_as_sequence,                /* tp_as_sequence */
+    (reprfunc)PyArray_repr,             /* tp_repr */
+    &PyArray_NumberMethods,             /* tp_as_number */
+    &PyArray_as_sequence,               /* tp_as_sequence */
     0,                                  /* tp_as_mapping */
     0,                                  /* tp_hash  */
-    (ternaryfunc)PyPoly_call,           /* tp_call */
+    0,                                  /* tp_call */
     0,                                  /* tp_str */
     0,                                  /* tp_getattro */
     0,                                  /* tp_setattro */
-    0,                                  /* tp_as_buffer */
+    &PyArray_as_buffer,                 /* tp_as_buffer */
 #if PY_MAJOR_VERSION < 3
     Py_TPFLAGS_CHECKTYPES |
     Py_TPFLAGS_HAVE_RICHCOMPARE |
+    Py_TPFLAGS_HAVE_NEWBUFFER |
 #endif
     Py_TPFLAGS_DEFAULT,                 /* tp_flags */
-    "Polynomial objects",               /* tp_doc */
+    "PolynomialArray(polynomials): a batch of polynomials stored contiguously,\n"
+    "with elementwise operators",
+                                        /* tp_doc */
     0,                                  /* tp_traverse */
     0,                                  /* tp_clear */
-    (richcmpfunc)PyPoly_compare,        /* tp_richcompare */
+    (richcmpfunc)PyArray_compare,       /* tp_richcompare */
     0,                                  /* tp_weaklistoffset */
     0,                                  /* tp_iter */
     0,                                  /* tp_iternext */
-    NULL,                               /* tp_methods */
-    PyPoly_members,                     /* tp_members */
+    PyArray_methods,                    /* tp_methods */
+    PyArray_members,                    /* tp_members */
     0,                                  /* tp_getset */
     0,                                  /* tp_base */
     0,                                  /* tp_dict */
@@ -650,24 +3617,225 @@ static PyTypeObject PyPoly_PolynomialType = {
     0,                                  /* tp_dictoffset */
     0,                                  /* tp_init */
     0,                                  /* tp_alloc */
-    (newfunc)PyPoly_new,                /* tp_new */
+    (newfunc)PyArray_new,               /* tp_new */
+};
+
+/* Classical orthogonal polynomials, and iterators over their successive
+ * degrees. */
+
+typedef int (*orthogonal_func)(int n, Polynomial *R);
+
+typedef struct {
+    PyObject_HEAD
+    orthogonal_func func;
+    int n;              /* Degree of the next polynomial */
+} PyPoly_OrthogonalIteratorObject;
+
+static PyObject*
+orthogonal_new(orthogonal_func func, int n)
+{
+    Polynomial R;
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "Degree cannot be negative");
+        return NULL;
+    }
+    if (!func(n, &R)) {
+        return PyErr_NoMemory();
+    }
+    ReturnPyPolyOrFree(R)
+}
+
+static PyObject*
+OrthogonalIterator_next(PyPoly_OrthogonalIteratorObject *self)
+{
+    if (self->n == INT_MAX) {
+        return NULL;
+    }
+    return orthogonal_new(self->func, self->n++);
+}
+
+static void
+OrthogonalIterator_dealloc(PyPoly_OrthogonalIteratorObject *self)
+{
+    PyObject_Del(self);
+}
+
+static PyTypeObject PyPoly_OrthogonalIteratorType = {
+#if PY_MAJOR_VERSION >= 3
+    PyVarObject_HEAD_INIT(NULL, 0)
+#else
+    PyObject_HEAD_INIT(NULL)
+    0,
+#endif
+    "OrthogonalIterator",               /* tp_name */
+    sizeof(PyPoly_OrthogonalIteratorObject),
+                                        /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)OrthogonalIterator_dealloc,
+                                        /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_reserved */
+    0,                                  /* tp_repr */
+    0,                                  /* tp_as_number */
+    0,                                  /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash  */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "Iterator over the successive degrees of a polynomial family",
+                                        /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    PyObject_SelfIter,                  /* tp_iter */
+    (iternextfunc)OrthogonalIterator_next,
+                                        /* tp_iternext */
+    0,                                  /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    0,                                  /* tp_new */
 };
 
+static PyObject*
+orthogonal_iterator_new(orthogonal_func func, PyObject *args)
+{
+    PyPoly_OrthogonalIteratorObject *it;
+    int start = 0;
+    if (!PyArg_ParseTuple(args, "|i", &start)) {
+        return NULL;
+    }
+    if (start < 0) {
+        PyErr_SetString(PyExc_ValueError, "Degree cannot be negative");
+        return NULL;
+    }
+    it = PyObject_New(PyPoly_OrthogonalIteratorObject, &PyPoly_OrthogonalIteratorType);
+    if (it != NULL) {
+        it->func = func;
+        it->n = start;
+    }
+    return (PyObject*)it;
+}
+
+#define ORTHOGONAL_FUNCTIONS(name)                                          \
+static PyObject*                                                            \
+PyPoly_##name(PyObject *self, PyObject *args)                               \
+{                                                                           \
+    int n;                                                                  \
+    (void)self;                                                             \
+    if (!PyArg_ParseTuple(args, "i", &n)) {                                 \
+        return NULL;                                                        \
+    }                                                                       \
+    return orthogonal_new(poly_##name, n);                                  \
+}                                                                           \
+static PyObject*                                                            \
+PyPoly_##name##_iterator(PyObject *self, PyObject *args)                    \
+{                                                                           \
+    (void)self;                                                             \
+    return orthogonal_iterator_new(poly_##name, args);                      \
+}
+
+ORTHOGONAL_FUNCTIONS(chebyshev)
+ORTHOGONAL_FUNCTIONS(legendre)
+ORTHOGONAL_FUNCTIONS(hermite)
+
 static PyMethodDef PyPolymethods[] = {
     {"gcd", PyPoly_gcd, METH_VARARGS,
      "Compute the GCD of two or more polynomials."},
+    {"sum", PyPoly_sum, METH_O,
+     "sum(iterable) -> the sum of the polynomials (or numbers) of iterable,\n"
+     "accumulated into a single result."},
+    {"linear_combination", PyPoly_linear_combination, METH_VARARGS,
+     "linear_combination(coeffs, polys) -> c0 * P0 + c1 * P1 + ...,\n"
+     "accumulated into a single result."},
+    {"alloc_stats", PyPoly_alloc_stats, METH_NOARGS,
+     "Coefficients memory allocation counters of the current thread."},
+    {"cpu_features", PyPoly_cpu_features, METH_NOARGS,
+     "CPU features detected at import, and the kernels in use."},
+    {"chebyshev", PyPoly_chebyshev, METH_VARARGS,
+     "chebyshev(n) -> T_n, Chebyshev polynomial of the first kind."},
+    {"legendre", PyPoly_legendre, METH_VARARGS,
+     "legendre(n) -> P_n, Legendre polynomial."},
+    {"hermite", PyPoly_hermite, METH_VARARGS,
+     "hermite(n) -> He_n, (probabilists') Hermite polynomial."},
+    {"chebyshev_iterator", PyPoly_chebyshev_iterator, METH_VARARGS,
+     "chebyshev_iterator([start]) -> iterator over T_start, T_start+1..."},
+    {"legendre_iterator", PyPoly_legendre_iterator, METH_VARARGS,
+     "legendre_iterator([start]) -> iterator over P_start, P_start+1..."},
+    {"hermite_iterator", PyPoly_hermite_iterator, METH_VARARGS,
+     "hermite_iterator([start]) -> iterator over He_start, He_start+1..."},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
+/* Coefficients arrays which are not served by the polynomials.c pools are
+ * allocated through the Python memory manager, so that they are visible to
+ * tracemalloc. The raw domain is used, since the pools of a thread are
+ * released when it exits, without the GIL. */
+#if PY_VERSION_HEX >= 0x03040000
+#define PyPoly_RawMalloc    PyMem_RawMalloc
+#define PyPoly_RawRealloc   PyMem_RawRealloc
+#define PyPoly_RawFree      PyMem_RawFree
+#else
+#define PyPoly_RawMalloc    PyMem_Malloc    /* The C library allocator */
+#define PyPoly_RawRealloc   PyMem_Realloc
+#define PyPoly_RawFree      PyMem_Free
+#endif
+
+static void*
+pymem_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return PyPoly_RawMalloc(size);
+}
+
+static void*
+pymem_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    return PyPoly_RawRealloc(ptr, size);
+}
+
+static void
+pymem_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    PyPoly_RawFree(ptr);
+}
+
+static const PolyAllocator pymem_allocator = {
+    NULL, pymem_malloc, pymem_realloc, pymem_free
+};
+
 #define PYPOLY_MODULE_DESC "Python C extension defining the Polynomial type."
 #if PY_MAJOR_VERSION >= 3
+static void
+PyPoly_module_free(void *m)
+{
+    (void)m;
+    clear_freelist();
+}
+
 static PyModuleDef PyPolymodule = {
     PyModuleDef_HEAD_INIT,
     "_pypoly",
     PYPOLY_MODULE_DESC,
     -1,
     PyPolymethods,
-    NULL, NULL, NULL, NULL
+    NULL, NULL, NULL,
+    PyPoly_module_free
 };
 
 PyMODINIT_FUNC
@@ -677,6 +3845,21 @@ PyInit__pypoly(void)
 
     if (PyType_Ready(&PyPoly_PolynomialType) < 0)
         return NULL;
+    if (PyType_Ready(&PyPoly_PowerSeriesType) < 0)
+        return NULL;
+    if (PyType_Ready(&PyPoly_ChebyshevSeriesType) < 0)
+        return NULL;
+    if (PyType_Ready(&PyPoly_LazyPolynomialType) < 0)
+        return NULL;
+    if (PyType_Ready(&PyPoly_PolynomialArrayType) < 0)
+        return NULL;
+    if (PyType_Ready(&PyPoly_OrthogonalIteratorType) < 0)
+        return NULL;
+
+    /* Unless an embedder already allocated through its own */
+    poly_set_allocator(&pymem_allocator);
+    /* PYPOLY_KERNELS=generic|avx2|avx512 overrides the detected kernels */
+    poly_cpu_init(getenv("PYPOLY_KERNELS"));
 
     m = PyModule_Create(&PyPolymodule);
     if (m == NULL)
@@ -685,6 +3868,14 @@ PyInit__pypoly(void)
     /* Add "Polynomial" type to module */
     Py_INCREF(&PyPoly_PolynomialType);
     PyModule_AddObject(m, "Polynomial", (PyObject *)&PyPoly_PolynomialType);
+    Py_INCREF(&PyPoly_PowerSeriesType);
+    PyModule_AddObject(m, "PowerSeries", (PyObject *)&PyPoly_PowerSeriesType);
+    Py_INCREF(&PyPoly_ChebyshevSeriesType);
+    PyModule_AddObject(m, "ChebyshevSeries", (PyObject *)&PyPoly_ChebyshevSeriesType);
+    Py_INCREF(&PyPoly_LazyPolynomialType);
+    PyModule_AddObject(m, "LazyPolynomial", (PyObject *)&PyPoly_LazyPolynomialType);
+    Py_INCREF(&PyPoly_PolynomialArrayType);
+    PyModule_AddObject(m, "PolynomialArray", (PyObject *)&PyPoly_PolynomialArrayType);
 
     return m;
 }
@@ -696,6 +3887,21 @@ init_pypoly(void)
 
     if (PyType_Ready(&PyPoly_PolynomialType) < 0)
         return;
+    if (PyType_Ready(&PyPoly_PowerSeriesType) < 0)
+        return;
+    if (PyType_Ready(&PyPoly_ChebyshevSeriesType) < 0)
+        return;
+    if (PyType_Ready(&PyPoly_LazyPolynomialType) < 0)
+        return;
+    if (PyType_Ready(&PyPoly_PolynomialArrayType) < 0)
+        return;
+    if (PyType_Ready(&PyPoly_OrthogonalIteratorType) < 0)
+        return;
+
+    /* Unless an embedder already allocated through its own */
+    poly_set_allocator(&pymem_allocator);
+    /* PYPOLY_KERNELS=generic|avx2|avx512 overrides the detected kernels */
+    poly_cpu_init(getenv("PYPOLY_KERNELS"));
 
     m = Py_InitModule3("_pypoly",
         PyPolymethods, PYPOLY_MODULE_DESC);
@@ -705,5 +3911,13 @@ init_pypoly(void)
     /* Add "Polynomial" type to module */
     Py_INCREF(&PyPoly_PolynomialType);
     PyModule_AddObject(m, "Polynomial", (PyObject *)&PyPoly_PolynomialType);
+    Py_INCREF(&PyPoly_PowerSeriesType);
+    PyModule_AddObject(m, "PowerSeries", (PyObject *)&PyPoly_PowerSeriesType);
+    Py_INCREF(&PyPoly_ChebyshevSeriesType);
+    PyModule_AddObject(m, "ChebyshevSeries", (PyObject *)&PyPoly_ChebyshevSeriesType);
+    Py_INCREF(&PyPoly_LazyPolynomialType);
+    PyModule_AddObject(m, "LazyPolynomial", (PyObject *)&PyPoly_LazyPolynomialType);
+    Py_INCREF(&PyPoly_PolynomialArrayType);
+    PyModule_AddObject(m, "PolynomialArray", (PyObject *)&PyPoly_PolynomialArrayType);
 }
 #endif
@@ -1,4 +1,6 @@
 from pypoly import Polynomial, X
+from pypoly import (chebyshev, chebyshev_iterator, legendre,
+                    legendre_iterator, hermite, hermite_iterator)
 
 #
 # 1 + X + X**2 + ...
@@ -12,59 +14,27 @@ def Ones(n):
 #
 
 def ChebyshevIterator():
-    U = 1
-    yield U
-    V = X
-    yield V
-    while True:
-        U, V = V, 2 * X * V - U
-        yield V
+    return chebyshev_iterator()
 
 def Chebyshev(n):
-    it = ChebyshevIterator()
-    for i in range(n):
-        next(it)
-    return next(it)
+    return chebyshev(n)
 
 #
 # Legendre polynomials
 #
 
 def LegendreIterator():
-    U = 1
-    yield U
-    V = X
-    yield V
-    n = 1
-    while True:
-        U, V = V, 1. / (n + 1) * ((2 * n + 1) * X * V - n * U)
-        yield V
-        n += 1
+    return legendre_iterator()
 
 def Legendre(n):
-    it = LegendreIterator()
-    for i in range(n):
-        next(it)
-    return next(it)
+    return legendre(n)
 
 #
 # Hermite polynomials
 #
 
 def HermiteIterator():
-    U = 1
-    yield U
-    V = X
-    yield V
-    n = 1
-    while True:
-        U, V = V, X * V - n * U
-        yield V
-        n += 1
+    return hermite_iterator()
 
 def Hermite(n):
-    it = HermiteIterator()
-    for i in range(n):
-        next(it)
-    return next(it)
-
+    return hermite(n)
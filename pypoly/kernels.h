@@ -0,0 +1,224 @@
+/* Core numerical kernels.
+ *
+ * This file is included several times by polynomials.c, once per instruction
+ * set, with the following macros defined:
+ *      KERNEL(name)        name of the kernel for this instruction set
+ *      KERNEL_TARGET       function attributes selecting the instruction set
+ *      KERNEL_MADD(a,b,c)  a * b + c, possibly fused
+ * so there is deliberately no include guard.
+ *
+ * Coefficients arrays are plain arrays of Complex, the loops are written so
+ * that the compiler can vectorize them for the target instruction set.
+ */
+
+/* r[j] += a * x[j], for j < n */
+static KERNEL_TARGET void
+KERNEL(axpy)(Complex *POLY_RESTRICT r, const Complex *POLY_RESTRICT x,
+             Complex a, int n)
+{
+    int j;
+    for (j = 0; j < n; ++j) {
+        r[j].real += KERNEL_MADD(a.real, x[j].real, -(a.imag * x[j].imag));
+        r[j].imag += KERNEL_MADD(a.real, x[j].imag, a.imag * x[j].real);
+    }
+}
+
+/* r[i + j] += (c * a[i]) * b[j], for i < na and j < nb: a schoolbook
+ * product accumulated into r, in a single call for short operands */
+static KERNEL_TARGET void
+KERNEL(mul_acc)(Complex *POLY_RESTRICT r, const Complex *POLY_RESTRICT a, int na,
+                const Complex *POLY_RESTRICT b, int nb, Complex c)
+{
+    double sr, si;
+    int i, j;
+    for (i = 0; i < na; ++i) {
+        sr = c.real * a[i].real - c.imag * a[i].imag;
+        si = c.real * a[i].imag + c.imag * a[i].real;
+        if (sr == 0. && si == 0.) {
+            continue;
+        }
+        for (j = 0; j < nb; ++j) {
+            r[i + j].real += KERNEL_MADD(sr, b[j].real, -(si * b[j].imag));
+            r[i + j].imag += KERNEL_MADD(sr, b[j].imag, si * b[j].real);
+        }
+    }
+}
+
+/* r[j] += x[j] * y[j], for j < n: the elementwise products of the
+ * polynomial arrays, one lane per polynomial */
+static KERNEL_TARGET void
+KERNEL(hadamard_acc)(Complex *POLY_RESTRICT r, const Complex *POLY_RESTRICT x,
+                     const Complex *POLY_RESTRICT y, int n)
+{
+    int j;
+    for (j = 0; j < n; ++j) {
+        r[j].real += KERNEL_MADD(x[j].real, y[j].real, -(x[j].imag * y[j].imag));
+        r[j].imag += KERNEL_MADD(x[j].real, y[j].imag, x[j].imag * y[j].real);
+    }
+}
+
+/* r[j] = x[j] + y[j], for j < n (r may be x or y) */
+static KERNEL_TARGET void
+KERNEL(add)(Complex *r, const Complex *x, const Complex *y, int n)
+{
+    double *rd = (double*)r;
+    const double *xd = (const double*)x, *yd = (const double*)y;
+    int j;
+    for (j = 0; j < 2 * n; ++j) {
+        rd[j] = xd[j] + yd[j];
+    }
+}
+
+/* r[j] = x[j] - y[j], for j < n (r may be x or y) */
+static KERNEL_TARGET void
+KERNEL(sub)(Complex *r, const Complex *x, const Complex *y, int n)
+{
+    double *rd = (double*)r;
+    const double *xd = (const double*)x, *yd = (const double*)y;
+    int j;
+    for (j = 0; j < 2 * n; ++j) {
+        rd[j] = xd[j] - yd[j];
+    }
+}
+
+/* r[j] = a * x[j], for j < n (r may be x) */
+static KERNEL_TARGET void
+KERNEL(scale)(Complex *r, const Complex *x, Complex a, int n)
+{
+    int j;
+    double xr, xi;
+    for (j = 0; j < n; ++j) {
+        xr = x[j].real;
+        xi = x[j].imag;
+        r[j].real = KERNEL_MADD(a.real, xr, -(a.imag * xi));
+        r[j].imag = KERNEL_MADD(a.real, xi, a.imag * xr);
+    }
+}
+
+/* r[j] *= f[j], for j < n */
+static KERNEL_TARGET void
+KERNEL(scale_real)(Complex *POLY_RESTRICT r, const double *POLY_RESTRICT f, int n)
+{
+    int j;
+    for (j = 0; j < n; ++j) {
+        r[j].real *= f[j];
+        r[j].imag *= f[j];
+    }
+}
+
+/* Horner's method: c[0] + c[1] * z + ... + c[deg] * z**deg */
+static KERNEL_TARGET Complex
+KERNEL(horner)(const Complex *c, int deg, Complex z)
+{
+    Complex r = {0., 0.};
+    double re;
+    int i;
+    for (i = deg; i >= 0; --i) {
+        re = KERNEL_MADD(r.real, z.real, -(r.imag * z.imag)) + c[i].real;
+        r.imag = KERNEL_MADD(r.real, z.imag, r.imag * z.real) + c[i].imag;
+        r.real = re;
+    }
+    return r;
+}
+
+/* Horner's method across the m polynomials of a PolyArray block, one lane
+ * per polynomial: the coefficient j of the polynomial l is c[j * stride + l].
+ * The polynomial l is evaluated at x[l * incx], incx being 0 for a common
+ * point. Lanes go HORNER_LANES at a time with the real and imaginary parts
+ * in separate arrays, so that the independent dependency chains of a block
+ * fill the vector units. */
+static KERNEL_TARGET void
+KERNEL(horner_lanes)(const Complex *c, int deg, int stride, const Complex *x,
+                     int incx, Complex *y, int m)
+{
+    double xr[HORNER_LANES], xi[HORNER_LANES];
+    double yr[HORNER_LANES], yi[HORNER_LANES];
+    double tr;
+    const Complex *cj;
+    int p, l, j, lanes;
+    for (p = 0; p < m; p += HORNER_LANES) {
+        lanes = (m - p < HORNER_LANES) ? m - p : HORNER_LANES;
+        for (l = 0; l < HORNER_LANES; ++l) {
+            xr[l] = (l < lanes) ? x[(p + l) * incx].real : 0.;
+            xi[l] = (l < lanes) ? x[(p + l) * incx].imag : 0.;
+            yr[l] = yi[l] = 0.;
+        }
+        if (lanes == HORNER_LANES) {
+            for (j = deg; j >= 0; --j) {
+                cj = c + j * stride + p;
+                for (l = 0; l < HORNER_LANES; ++l) {
+                    tr = KERNEL_MADD(yr[l], xr[l], -(yi[l] * xi[l])) + cj[l].real;
+                    yi[l] = KERNEL_MADD(yr[l], xi[l], yi[l] * xr[l]) + cj[l].imag;
+                    yr[l] = tr;
+                }
+            }
+        } else {
+            for (j = deg; j >= 0; --j) {
+                cj = c + j * stride + p;
+                for (l = 0; l < lanes; ++l) {
+                    tr = KERNEL_MADD(yr[l], xr[l], -(yi[l] * xi[l])) + cj[l].real;
+                    yi[l] = KERNEL_MADD(yr[l], xi[l], yi[l] * xr[l]) + cj[l].imag;
+                    yr[l] = tr;
+                }
+            }
+        }
+        for (l = 0; l < lanes; ++l) {
+            y[p + l].real = yr[l];
+            y[p + l].imag = yi[l];
+        }
+    }
+}
+
+/* Clenshaw's recurrence for the Chebyshev series c[0] T_0 + ... + c[deg] T_deg
+ * at the m points x, into y. The points are processed CLENSHAW_LANES at a
+ * time with the real and imaginary parts in separate arrays, so that the
+ * loop over the lanes of independent recurrences vectorizes. */
+static KERNEL_TARGET void
+KERNEL(clenshaw)(const Complex *c, int deg, const Complex *x, Complex *y, int m)
+{
+    double xr[CLENSHAW_LANES], xi[CLENSHAW_LANES];
+    double b1r[CLENSHAW_LANES], b1i[CLENSHAW_LANES];
+    double b2r[CLENSHAW_LANES], b2i[CLENSHAW_LANES];
+    double tr, ti;
+    int p, l, k, lanes;
+    for (p = 0; p < m; p += CLENSHAW_LANES) {
+        lanes = (m - p < CLENSHAW_LANES) ? m - p : CLENSHAW_LANES;
+        for (l = 0; l < CLENSHAW_LANES; ++l) {
+            xr[l] = (l < lanes) ? 2. * x[p + l].real : 0.;
+            xi[l] = (l < lanes) ? 2. * x[p + l].imag : 0.;
+            b1r[l] = b1i[l] = b2r[l] = b2i[l] = 0.;
+        }
+        /* b_k = c_k + 2 x b_{k+1} - b_{k+2} */
+        for (k = deg; k >= 1; --k) {
+            for (l = 0; l < CLENSHAW_LANES; ++l) {
+                tr = KERNEL_MADD(xr[l], b1r[l], -(xi[l] * b1i[l])) - b2r[l] + c[k].real;
+                ti = KERNEL_MADD(xr[l], b1i[l], xi[l] * b1r[l]) - b2i[l] + c[k].imag;
+                b2r[l] = b1r[l];
+                b2i[l] = b1i[l];
+                b1r[l] = tr;
+                b1i[l] = ti;
+            }
+        }
+        /* c_0 + x b_1 - b_2 */
+        for (l = 0; l < lanes; ++l) {
+            y[p + l].real = (deg < 0) ? 0. : c[0].real - b2r[l]
+                + 0.5 * (xr[l] * b1r[l] - xi[l] * b1i[l]);
+            y[p + l].imag = (deg < 0) ? 0. : c[0].imag - b2i[l]
+                + 0.5 * (xr[l] * b1i[l] + xi[l] * b1r[l]);
+        }
+    }
+}
+
+static const PolyKernels KERNEL(kernels) = {
+    KERNEL_NAME,
+    KERNEL(axpy),
+    KERNEL(mul_acc),
+    KERNEL(hadamard_acc),
+    KERNEL(add),
+    KERNEL(sub),
+    KERNEL(scale),
+    KERNEL(scale_real),
+    KERNEL(horner),
+    KERNEL(horner_lanes),
+    KERNEL(clenshaw)
+};
@@ -1,15 +1,26 @@
 #include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "polynomials.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#include <intrin.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
 /**
  * Generic helpers
  */
 
 #define MAX(a,b)    (((int)(a)>(int)(b))?(int)(a):(int)(b))
+#define MIN(a,b)    (((int)(a)<(int)(b))?(int)(a):(int)(b))
 
 /* strdup is not part of the C standard and might not be available */
 static inline char*
@@ -30,62 +41,660 @@ strduplicate(const char *s)
 
 const Complex CZero = {0., 0.}, COne = {1., 0.};
 
-#ifndef PYPOLY_VERSION
+/* These are deliberately inline in every build (including the Python
+ * extension, although cPython exports equivalent _Py_c_* functions): they
+ * are used in the innermost loops, which the compiler can then unroll,
+ * vectorize and contract into FMAs where the target allows it. */
 static inline Complex
 complex_add(Complex a, Complex b)
 {
-    return (Complex){
-        a.real + b.real,
-        a.imag + b.imag
-    };
+    Complex r;
+    r.real = a.real + b.real;
+    r.imag = a.imag + b.imag;
+    return r;
 }
 static inline Complex
 complex_sub(Complex a, Complex b)
 {
-    return (Complex){
-        a.real - b.real,
-        a.imag - b.imag
-    };
+    Complex r;
+    r.real = a.real - b.real;
+    r.imag = a.imag - b.imag;
+    return r;
 }
 static inline Complex
 complex_neg(Complex z)
 {
-    return (Complex){
-        - z.real,
-        - z.imag
-    };
+    Complex r;
+    r.real = - z.real;
+    r.imag = - z.imag;
+    return r;
 }
 static inline Complex
 complex_mult(Complex a, Complex b)
 {
-    return (Complex){
-        a.real * b.real - a.imag * b.imag,
-        a.real * b.imag + a.imag * b.real
-    };
+    Complex r;
+    r.real = a.real * b.real - a.imag * b.imag;
+    r.imag = a.real * b.imag + a.imag * b.real;
+    return r;
+}
+static inline Complex
+complex_mult_real(Complex a, double b)
+{
+    Complex r;
+    r.real = a.real * b;
+    r.imag = a.imag * b;
+    return r;
 }
+/* Division is not in the hot loops: it uses Smith's algorithm (as cPython
+ * does) to avoid overflows / underflows when scaling by |b|**2.
+ * Division by zero sets errno to EDOM and returns 0. */
 static inline Complex
 complex_div(Complex a, Complex b)
 {
     Complex r;
-    double d = b.real*b.real + b.imag*b.imag;
-    if (d == 0.) {
-        errno = EDOM;
+    double ratio, denom;
+    if (fabs(b.real) >= fabs(b.imag)) {
+        if (b.real == 0.) {
+            errno = EDOM;
+            r.real = r.imag = 0.;
+        } else {
+            ratio = b.imag / b.real;
+            denom = b.real + b.imag * ratio;
+            r.real = (a.real + a.imag * ratio) / denom;
+            r.imag = (a.imag - a.real * ratio) / denom;
+        }
+    } else if (fabs(b.imag) >= fabs(b.real)) {
+        ratio = b.real / b.imag;
+        denom = b.real * ratio + b.imag;
+        r.real = (a.real * ratio + a.imag) / denom;
+        r.imag = (a.imag * ratio - a.real) / denom;
+    } else {
+        /* At least one of b.real or b.imag is a NaN */
+        r.real = r.imag = b.real + b.imag;
+    }
+    return r;
+}
+
+/* Principal branches of the elementary functions, for power series */
+static Complex
+complex_log(Complex z)
+{
+    Complex r;
+    r.real = log(hypot(z.real, z.imag));
+    r.imag = atan2(z.imag, z.real);
+    return r;
+}
+static Complex
+complex_exp(Complex z)
+{
+    Complex r;
+    double m = exp(z.real);
+    r.real = m * cos(z.imag);
+    r.imag = m * sin(z.imag);
+    return r;
+}
+static Complex
+complex_sqrt(Complex z)
+{
+    Complex r;
+    double m = hypot(z.real, z.imag), t;
+    if (m == 0.) {
+        return CZero;
+    }
+    if (z.real >= 0.) {
+        t = sqrt((m + z.real) / 2);
+        r.real = t;
+        r.imag = z.imag / (2 * t);
     } else {
-        r.real = (a.real*b.real + a.imag*b.imag)/d;
-        r.imag = (a.imag*b.real - a.real*b.imag)/d;
+        t = sqrt((m - z.real) / 2);
+        r.real = fabs(z.imag) / (2 * t);
+        r.imag = copysign(t, z.imag);
     }
     return r;
 }
+
+/**
+ * Core kernels and runtime CPU dispatch
+ *
+ * The innermost loops are compiled for several instruction sets, and the best
+ * variant supported by the host is selected by poly_cpu_init, so that a single
+ * (portable) binary runs at full speed everywhere.
+ * Note that the FMA capable variants round differently from the generic one.
+ */
+
+#if defined(_MSC_VER)
+#define POLY_RESTRICT __restrict
+#else
+#define POLY_RESTRICT restrict
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && !defined(PYPOLY_NO_DISPATCH)
+#define POLY_DISPATCH_X86
+#endif
+
+#define CLENSHAW_LANES          32  /* Independent recurrences per batch in the
+                                     * clenshaw kernel, enough to hide the
+                                     * latency of its multiply-add chain */
+#define HORNER_LANES            32  /* Same for the horner_lanes kernel */
+
+typedef struct {
+    const char *name;
+    void (*axpy)(Complex *POLY_RESTRICT, const Complex *POLY_RESTRICT, Complex, int);
+    void (*mul_acc)(Complex *POLY_RESTRICT, const Complex *POLY_RESTRICT, int,
+                    const Complex *POLY_RESTRICT, int, Complex);
+    void (*hadamard_acc)(Complex *POLY_RESTRICT, const Complex *POLY_RESTRICT,
+                         const Complex *POLY_RESTRICT, int);
+    void (*add)(Complex*, const Complex*, const Complex*, int);
+    void (*sub)(Complex*, const Complex*, const Complex*, int);
+    void (*scale)(Complex*, const Complex*, Complex, int);
+    void (*scale_real)(Complex *POLY_RESTRICT, const double *POLY_RESTRICT, int);
+    Complex (*horner)(const Complex*, int, Complex);
+    void (*horner_lanes)(const Complex*, int, int, const Complex*, int, Complex*, int);
+    void (*clenshaw)(const Complex*, int, const Complex*, Complex*, int);
+} PolyKernels;
+
+#define KERNEL(name)            name##_generic
+#define KERNEL_NAME             "generic"
+#define KERNEL_TARGET
+#define KERNEL_MADD(a, b, c)    ((a) * (b) + (c))
+#include "kernels.h"
+#undef KERNEL
+#undef KERNEL_NAME
+#undef KERNEL_TARGET
+#undef KERNEL_MADD
+
+#ifdef POLY_DISPATCH_X86
+#define KERNEL(name)            name##_avx2
+#define KERNEL_NAME             "avx2"
+#define KERNEL_TARGET           __attribute__((target("avx2,fma")))
+#define KERNEL_MADD(a, b, c)    __builtin_fma((a), (b), (c))
+#include "kernels.h"
+#undef KERNEL
+#undef KERNEL_NAME
+#undef KERNEL_TARGET
+
+#define KERNEL(name)            name##_avx512
+#define KERNEL_NAME             "avx512"
+#define KERNEL_TARGET           __attribute__((target("avx512f,avx512vl,avx2,fma")))
+#include "kernels.h"
+#undef KERNEL
+#undef KERNEL_NAME
+#undef KERNEL_TARGET
+#undef KERNEL_MADD
+#endif
+
+static const PolyKernels *kernels = &kernels_generic;
+static unsigned int cpu_features = 0;
+
+/* Detect the CPU features and select the kernels accordingly.
+ * If "name" is not NULL, the kernels with this name are selected instead,
+ * provided they are supported: returns 0 otherwise. */
+int
+poly_cpu_init(const char *name)
+{
+    const PolyKernels *available[3];
+    int i, n = 0;
+    available[n++] = &kernels_generic;
+    cpu_features = 0;
+#ifdef POLY_DISPATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) cpu_features |= POLY_CPU_AVX2;
+    if (__builtin_cpu_supports("fma")) cpu_features |= POLY_CPU_FMA;
+    if (__builtin_cpu_supports("avx512f")) cpu_features |= POLY_CPU_AVX512F;
+    if (__builtin_cpu_supports("avx512vl")) cpu_features |= POLY_CPU_AVX512VL;
+    if ((cpu_features & POLY_CPU_AVX2) && (cpu_features & POLY_CPU_FMA)) {
+        available[n++] = &kernels_avx2;
+        if ((cpu_features & POLY_CPU_AVX512F) && (cpu_features & POLY_CPU_AVX512VL)) {
+            available[n++] = &kernels_avx512;
+        }
+    }
+#endif
+    kernels = available[n - 1];
+    if (name == NULL) {
+        return 1;
+    }
+    for (i = 0; i < n; ++i) {
+        if (strcmp(name, available[i]->name) == 0) {
+            kernels = available[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+unsigned int
+poly_cpu_features(void)
+{
+    return cpu_features;
+}
+
+const char*
+poly_kernels_name(void)
+{
+    return kernels->name;
+}
+
+/**
+ * Memory allocation
+ *
+ * Coefficients arrays are preceded by a header slot holding a reference
+ * count, so that copies of a Polynomial can share its coefficients until
+ * one of them gets modified (copy-on-write).
+ *
+ * Blocks (header included) of up to 2**(POLY_POOL_CLASSES - 1) slots are
+ * rounded up to the next power of two, and kept in a per-class freelist when
+ * released, so that algorithms creating many temporaries of the same size
+ * mostly recycle memory. Each thread has its own pools, hence no locking,
+ * which are released when the thread exits. Blocks are chained through
+ * their first bytes while in a pool.
+ *
+ * Copies sharing an array may live in different threads, so its reference
+ * count is updated atomically.
+ */
+
+#ifndef POLY_POOL_CLASSES
+#define POLY_POOL_CLASSES   10      /* Up to 512 coefficients (8 KiB) */
+#endif
+#ifndef POLY_POOL_DEPTH
+#define POLY_POOL_DEPTH     32      /* Cached arrays per size class */
+#endif
+
+#if defined(_MSC_VER)
+#define POLY_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define POLY_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define POLY_THREAD_LOCAL _Thread_local
+#else
+#define POLY_THREAD_LOCAL   /* Callers must serialize (e.g. hold the GIL) */
+#define POLY_SHARED_POOLS
+#endif
+
+#if defined(__GNUC__)
+#define Atomic_Load(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define Atomic_Store(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define Atomic_Incr(p)      __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+#define Atomic_Decr(p)      __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#elif defined(_MSC_VER)
+#define Atomic_Load(p)      (*(volatile long*)(p))
+#define Atomic_Store(p, v)  (*(volatile long*)(p) = (v))
+#define Atomic_Incr(p)      _InterlockedIncrement((volatile long*)(p))
+#define Atomic_Decr(p)      _InterlockedDecrement((volatile long*)(p))
+#else                       /* Callers must serialize (e.g. hold the GIL) */
+#define Atomic_Load(p)      (*(p))
+#define Atomic_Store(p, v)  (*(p) = (v))
+#define Atomic_Incr(p)      (++*(p))
+#define Atomic_Decr(p)      (--*(p))
+#endif
+
+typedef struct PoolBlock {
+    struct PoolBlock *next;
+} PoolBlock;
+
+typedef struct {
+    PoolBlock *blocks[POLY_POOL_CLASSES];
+    int count[POLY_POOL_CLASSES];
+    int registered;         /* Whether the pools are released at thread exit */
+    PolyAllocStats stats;
+} PolyPools;
+
+static POLY_THREAD_LOCAL PolyPools pools;
+
+/* Arrange for the pools of the calling thread to be released when it exits,
+ * with a thread-specific key whose destructor clears them. */
+#if defined(_WIN32) && !defined(POLY_SHARED_POOLS)
+static INIT_ONCE pool_key_once = INIT_ONCE_STATIC_INIT;
+static DWORD pool_key = FLS_OUT_OF_INDEXES;
+
+static void WINAPI
+pool_thread_exit(void *value)
+{
+    (void)value;
+    poly_clear_pools();
+}
+
+static BOOL CALLBACK
+pool_key_create(PINIT_ONCE once, void *param, void **ctx)
+{
+    (void)once; (void)param; (void)ctx;
+    pool_key = FlsAlloc(pool_thread_exit);
+    return TRUE;
+}
+
+static void
+pool_register_thread(void)
+{
+    InitOnceExecuteOnce(&pool_key_once, pool_key_create, NULL, NULL);
+    if (pool_key != FLS_OUT_OF_INDEXES && FlsSetValue(pool_key, &pools)) {
+        pools.registered = 1;
+    }
+}
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(POLY_SHARED_POOLS)
+static pthread_once_t pool_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t pool_key;
+static int pool_key_created;
+
+static void
+pool_thread_exit(void *value)
+{
+    (void)value;
+    poly_clear_pools();
+}
+
+static void
+pool_key_create(void)
+{
+    pool_key_created = (pthread_key_create(&pool_key, pool_thread_exit) == 0);
+}
+
+static void
+pool_register_thread(void)
+{
+    pthread_once(&pool_key_once, pool_key_create);
+    if (pool_key_created && pthread_setspecific(pool_key, &pools) == 0) {
+        pools.registered = 1;
+    }
+}
 #else
-/* cPython comes with good implementations of operations on complex numbers.
- * Let's use them! */
-#define complex_add _Py_c_sum
-#define complex_sub _Py_c_diff
-#define complex_neg _Py_c_neg
-#define complex_mult _Py_c_prod
-#define complex_div _Py_c_quot
+static void
+pool_register_thread(void)
+{
+    pools.registered = 1;
+}
 #endif
 
+typedef union {
+    long refcnt;
+    Complex align;
+} CoefHeader;
+
+#define Coef_Header(coef)       ((CoefHeader*)(void*)(coef) - 1)
+#define Coef_Block(header)      ((Complex*)(void*)((CoefHeader*)(header) + 1))
+
+static void*
+default_malloc(void *ctx, size_t size)
+{
+    (void)ctx;
+    return malloc(size);
+}
+
+static void*
+default_realloc(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    return realloc(ptr, size);
+}
+
+static void
+default_free(void *ctx, void *ptr)
+{
+    (void)ctx;
+    free(ptr);
+}
+
+static PolyAllocator allocator = {
+    NULL, default_malloc, default_realloc, default_free
+};
+
+/* Set once the allocator has handed out a block: it can no longer change */
+static long allocator_used;
+
+void
+poly_get_allocator(PolyAllocator *a)
+{
+    *a = allocator;
+}
+
+/* Blocks may be cached in the pools of any thread, or shared by copies:
+ * they could not be given back to the allocator they came from. Hence the
+ * allocator can only be replaced before the first allocation. Returns 1 if
+ * "a" is the allocator in use, 0 otherwise. */
+int
+poly_set_allocator(const PolyAllocator *a)
+{
+    if (a->ctx == allocator.ctx && a->malloc == allocator.malloc
+        && a->realloc == allocator.realloc && a->free == allocator.free) {
+        return 1;
+    }
+    if (Atomic_Load(&allocator_used)) {
+        return 0;
+    }
+    allocator = *a;
+    return 1;
+}
+
+void
+poly_get_alloc_stats(PolyAllocStats *stats)
+{
+    *stats = pools.stats;
+}
+
+void
+poly_reset_alloc_stats(void)
+{
+    memset(&pools.stats, 0, sizeof(PolyAllocStats));
+}
+
+/* Release the arrays cached by the pools of the calling thread */
+void
+poly_clear_pools(void)
+{
+    int k;
+    PoolBlock *block;
+    pools.registered = 0;   /* a later release registers the thread again */
+    for (k = 0; k < POLY_POOL_CLASSES; ++k) {
+        while ((block = pools.blocks[k]) != NULL) {
+            pools.blocks[k] = block->next;
+            allocator.free(allocator.ctx, block);
+            ++pools.stats.system_frees;
+        }
+        pools.count[k] = 0;
+    }
+}
+
+/* Size class of an array of "capacity" coefficients, -1 if not pooled */
+static inline int
+pool_class(int capacity)
+{
+    int k = 0;
+    while (k < POLY_POOL_CLASSES && (1 << k) < capacity + 1) ++k;
+    return (k < POLY_POOL_CLASSES) ? k : -1;
+}
+
+/* Actual number of coefficients allocated when "capacity" is requested */
+static inline int
+pool_capacity(int capacity)
+{
+    int k = pool_class(capacity);
+    return (k == -1 || capacity == 0) ? capacity : (1 << k) - 1;
+}
+
+/* Allocate an array of "capacity" coefficients, which must be a value
+ * returned by pool_capacity. The array is not initialized, and its
+ * reference count is 1. */
+static Complex*
+coef_alloc(int capacity)
+{
+    int k = pool_class(capacity);
+    CoefHeader *h;
+    ++pools.stats.allocs;
+    if (k != -1 && pools.blocks[k] != NULL) {
+        h = (CoefHeader*)(void*)pools.blocks[k];
+        pools.blocks[k] = pools.blocks[k]->next;
+        --pools.count[k];
+        ++pools.stats.pool_hits;
+    } else {
+        ++pools.stats.system_allocs;
+        if (!Atomic_Load(&allocator_used)) {
+            Atomic_Store(&allocator_used, 1);
+        }
+        h = allocator.malloc(allocator.ctx, (capacity + 1) * sizeof(Complex));
+        if (h == NULL) {
+            --pools.stats.allocs;
+            return NULL;
+        }
+    }
+    h->refcnt = 1;
+    return Coef_Block(h);
+}
+
+/* Release a reference to an array of "capacity" coefficients */
+static void
+coef_free(Complex *coef, int capacity)
+{
+    int k;
+    void *block;
+    if (coef == NULL || Atomic_Decr(&Coef_Header(coef)->refcnt) > 0) {
+        return;
+    }
+    k = pool_class(capacity);
+    block = Coef_Header(coef);
+    ++pools.stats.frees;
+    if (k != -1 && pools.count[k] < POLY_POOL_DEPTH) {
+        if (!pools.registered) {
+            pool_register_thread();
+        }
+        ((PoolBlock*)block)->next = pools.blocks[k];
+        pools.blocks[k] = (PoolBlock*)block;
+        ++pools.count[k];
+        return;
+    }
+    ++pools.stats.system_frees;
+    allocator.free(allocator.ctx, block);
+}
+
+/* Move a non shared array of "capacity" coefficients, of which the first
+ * "used" are meaningful, to an array of "new_capacity" coefficients.
+ * Both capacities must be values returned by pool_capacity. */
+static Complex*
+coef_realloc(Complex *coef, int capacity, int used, int new_capacity)
+{
+    Complex *p;
+    CoefHeader *h;
+    if (coef == NULL) {
+        return coef_alloc(new_capacity);
+    }
+    if (pool_class(capacity) == -1 && pool_class(new_capacity) == -1) {
+        ++pools.stats.system_allocs;
+        h = allocator.realloc(allocator.ctx, Coef_Header(coef),
+                              (new_capacity + 1) * sizeof(Complex));
+        return (h == NULL) ? NULL : Coef_Block(h);
+    }
+    if ((p = coef_alloc(new_capacity)) == NULL) {
+        return NULL;
+    }
+    memcpy(p, coef, MIN(used, new_capacity) * sizeof(Complex));
+    coef_free(coef, capacity);
+    return p;
+}
+
+/**
+ * Scratch arena
+ *
+ * Chunks are coefficients arrays (hence pooled when small) whose first slots
+ * hold the chunk header. The first chunk is sized after the hint given by the
+ * algorithm, so that an accurate hint means a single allocation.
+ */
+
+struct PolyArenaChunk {
+    PolyArenaChunk *prev;
+    int capacity;           /* In coefficients, header excluded */
+    int used;
+};
+
+#define ARENA_HEADER_SLOTS                                              \
+    ((int)((sizeof(PolyArenaChunk) + sizeof(Complex) - 1) / sizeof(Complex)))
+#define ARENA_MIN_CHUNK     64
+
+void
+poly_arena_init(PolyArena *arena, int hint)
+{
+    arena->chunk = NULL;
+    arena->hint = hint;
+}
+
+static void
+arena_free_chunk(PolyArenaChunk *chunk)
+{
+    coef_free((Complex*)(void*)chunk, chunk->capacity + ARENA_HEADER_SLOTS);
+}
+
+/* Allocate n uninitialized coefficients from the arena */
+Complex*
+poly_arena_alloc(PolyArena *arena, int n)
+{
+    PolyArenaChunk *chunk = arena->chunk;
+    Complex *p;
+    if (chunk == NULL || chunk->used + n > chunk->capacity) {
+        int capacity = MAX(n, MAX(arena->hint, ARENA_MIN_CHUNK));
+        if (chunk != NULL) {
+            capacity = MAX(capacity, 2 * chunk->capacity);
+        }
+        capacity = pool_capacity(capacity + ARENA_HEADER_SLOTS);
+        if ((p = coef_alloc(capacity)) == NULL) {
+            return NULL;
+        }
+        chunk = (PolyArenaChunk*)(void*)p;
+        chunk->prev = arena->chunk;
+        chunk->capacity = capacity - ARENA_HEADER_SLOTS;
+        chunk->used = 0;
+        arena->chunk = chunk;
+    }
+    p = (Complex*)(void*)chunk + ARENA_HEADER_SLOTS + chunk->used;
+    chunk->used += n;
+    return p;
+}
+
+/* Initialize P as a zero Polynomial of degree "deg" drawn from the arena */
+int
+poly_arena_poly(PolyArena *arena, Polynomial *P, int deg)
+{
+    if (deg == -1) {
+        P->coef = NULL;
+    } else if ((P->coef = poly_arena_alloc(arena, deg + 1)) == NULL) {
+        return 0;
+    } else {
+        memset(P->coef, 0, (deg + 1) * sizeof(Complex));
+    }
+    P->deg = deg;
+    P->capacity = deg + 1;
+    P->bloom = 0;
+    P->flags = POLY_BORROWED;
+    return 1;
+}
+
+PolyArenaMark
+poly_arena_mark(PolyArena *arena)
+{
+    PolyArenaMark mark;
+    mark.chunk = arena->chunk;
+    mark.used = (arena->chunk != NULL) ? arena->chunk->used : 0;
+    return mark;
+}
+
+/* Release everything allocated from the arena since "mark" was taken */
+void
+poly_arena_rewind(PolyArena *arena, PolyArenaMark mark)
+{
+    PolyArenaChunk *chunk;
+    while (arena->chunk != mark.chunk) {
+        chunk = arena->chunk;
+        arena->chunk = chunk->prev;
+        arena_free_chunk(chunk);
+    }
+    if (arena->chunk != NULL) {
+        arena->chunk->used = mark.used;
+    }
+}
+
+void
+poly_arena_release(PolyArena *arena)
+{
+    PolyArenaMark start = {NULL, 0};
+    poly_arena_rewind(arena, start);
+}
+
 /**
  * Polynomials
  */
@@ -107,14 +716,18 @@ complex_div(Complex a, Complex b)
 int
 poly_init(Polynomial *P, int deg)
 {
+    int capacity = (deg == -1) ? 0 : pool_capacity(deg + 1);
     if (deg == -1) {
         P->coef = NULL;
-    } else if ((P->coef = calloc(deg + 1, sizeof(Complex))) == NULL) {
-        P->coef = NULL;
+    } else if ((P->coef = coef_alloc(capacity)) == NULL) {
         return 0;
+    } else {
+        memset(P->coef, 0, (deg + 1) * sizeof(Complex));
     }
     P->deg = deg;
+    P->capacity = capacity;
     P->bloom = 0;
+    P->flags = 0;
     return 1;
 }
 
@@ -122,8 +735,12 @@ poly_init(Polynomial *P, int deg)
 void
 poly_free(Polynomial *P)
 {
-    free(P->coef);
+    if (!(P->flags & POLY_BORROWED)) {
+        coef_free(P->coef, P->capacity);
+    }
     P->coef = NULL;
+    P->capacity = 0;
+    P->flags = 0;
 }
 
 static inline void
@@ -141,50 +758,206 @@ _poly_incr_coef(Polynomial *P, int i, Complex c)
     P->coef[i].imag += c.imag;
 }
 
+/* Recompute the bloom filter of P from scratch.
+ * Needed when coefficients were overwritten in place, since the
+ * filter can only be extended by _poly_set_coef. */
+static inline void
+_poly_reset_bloom(Polynomial *P)
+{
+    int i;
+    P->bloom = 0;
+    for (i = 0; i <= P->deg; ++i) {
+        if (!complex_iszero(P->coef[i])) P->bloom |= Poly_BloomMask(i);
+    }
+}
+
 void
 poly_set_coef(Polynomial *P, int i, Complex c)
 {
-    /* /!\ i should be <= allocated */
+    /* /!\ i should be <= allocated, and P writable (see poly_make_writable) */
     _poly_set_coef(P, i, c);
     if (i > P->deg && !complex_iszero(c)) {
         P->deg = i;
-    } else if (i == P->deg) {
+    } else if (i == P->deg && !(P->flags & POLY_PINNED)) {
         Poly_ResizeDown(P);
     }
 }
 
-/* Reallocate memory for P (e.g. for setting a new coef. higher than previous degree)
- *
- * /!\ This function assumes poly_set_coef will be called afterwards
- * so that the degree gets properly computed.
- */
-int
-poly_realloc(Polynomial *P, int deg)
+/* Whether the coefficients of P are shared with other Polynomials */
+#define Poly_IsShared(P)                                \
+    (!((P)->flags & POLY_BORROWED) && (P)->coef != NULL \
+     && Atomic_Load(&Coef_Header((P)->coef)->refcnt) > 1)
+
+/* Move the coefficients of P to a private array of (at least) "capacity"
+ * coefficients, leaving the current array to its owner(s). */
+static int
+_poly_move_storage(Polynomial *P, int capacity)
 {
-    Complex *coef = realloc(P->coef, (deg + 1) * sizeof(Complex));
-    if (coef == NULL) {
+    Complex *coef = NULL;
+    capacity = pool_capacity(MAX(capacity, P->deg + 1));
+    if (capacity > 0 && (coef = coef_alloc(capacity)) == NULL) {
         return 0;
     }
-    if (deg > P->deg) {
-        memset(coef + P->deg + 1, 0, (deg - P->deg) * sizeof(Complex));
+    if (P->deg >= 0) {
+        memcpy(coef, P->coef, (P->deg + 1) * sizeof(Complex));
+    }
+    if (!(P->flags & POLY_BORROWED)) {
+        coef_free(P->coef, P->capacity);
     }
     P->coef = coef;
-    P->deg = deg;
+    P->capacity = capacity;
+    P->flags &= ~POLY_BORROWED;
     return 1;
 }
 
-int
-poly_equal(Polynomial *P, Polynomial *Q)
+/* Resize the coefficients array of P to (at least) "capacity" coefficients.
+ * The degree is left untouched and must fit in the new capacity. */
+static int
+_poly_set_capacity(Polynomial *P, int capacity)
 {
-    if (P == Q) return 1;
-    if (P->deg != Q->deg) return 0;
-    int i;
-    for (i = 0; i <= P->deg; ++i) {
-        if (P->coef[i].real != Q->coef[i].real
-                ||
-            P->coef[i].imag != Q->coef[i].imag) {
-            return 0;
-        }
+    Complex *coef = NULL;
+    if ((P->flags & POLY_BORROWED) || Poly_IsShared(P)) {
+        return _poly_move_storage(P, capacity);
+    }
+    capacity = pool_capacity(capacity);
+    if (capacity == P->capacity) {
+        return 1;
+    }
+    if (capacity == 0) {
+        coef_free(P->coef, P->capacity);
+        coef = NULL;
+    } else if ((coef = coef_realloc(P->coef, P->capacity,
+                                    P->deg + 1, capacity)) == NULL) {
+        return 0;
+    }
+    P->coef = coef;
+    P->capacity = capacity;
+    return 1;
+}
+
+/* Make sure the coefficients of P can be modified in place, i.e. that they
+ * are not shared with another Polynomial (copy-on-write). */
+int
+poly_make_writable(Polynomial *P)
+{
+    if (!Poly_IsShared(P)) {
+        return 1;
+    }
+    return _poly_move_storage(P, P->capacity);
+}
+
+/* Recompute the degree (lowered from P->deg) and the bloom filter of P,
+ * after its coefficients were written directly */
+void
+poly_normalize(Polynomial *P)
+{
+    Poly_ResizeDown(P);
+    _poly_reset_bloom(P);
+}
+
+/* Make P the Polynomial whose n coefficients are stored at "coef", which
+ * P does not own (POLY_BORROWED): they are updated in place, and moved to
+ * regular storage if P has to grow. They must outlive P. As they may also
+ * be updated by their owner, P is pinned (see poly_pin). */
+void
+poly_borrow(Polynomial *P, Complex *coef, int n)
+{
+    P->coef = (n > 0) ? coef : NULL;
+    P->capacity = n;
+    P->flags = POLY_BORROWED | POLY_PINNED;
+    P->bloom = ~(uint32_t)0;
+    poly_sync(P, n);
+}
+
+/* Pin the coefficients of P, which are about to be updated directly by
+ * external code (e.g. through a buffer view): they are made writable, are
+ * no longer shared by copies, and the bloom filter is saturated since it
+ * cannot follow such updates. Neither does the degree: in-place functions
+ * leave it as is rather than lowering it, and poly_sync recomputes it before
+ * P is used. The caller must not move the coefficients until poly_unpin,
+ * which recomputes the degree and the bloom filter. */
+int
+poly_pin(Polynomial *P)
+{
+    if (!poly_make_writable(P)) {
+        return 0;
+    }
+    P->flags |= POLY_PINNED;
+    P->bloom = ~(uint32_t)0;
+    return 1;
+}
+
+void
+poly_unpin(Polynomial *P)
+{
+    P->flags &= ~POLY_PINNED;
+    poly_normalize(P);
+}
+
+/* Recompute the degree of the pinned P, whose first n coefficients may have
+ * been updated externally */
+void
+poly_sync(Polynomial *P, int n)
+{
+    P->deg = n - 1;
+    Poly_ResizeDown(P);
+}
+
+/* Make sure P can hold at least "capacity" coefficients without reallocation */
+int
+poly_reserve(Polynomial *P, int capacity)
+{
+    if (capacity <= P->capacity) {
+        return 1;
+    }
+    return _poly_set_capacity(P, capacity);
+}
+
+/* Release the unused capacity of P */
+int
+poly_shrink_to_fit(Polynomial *P)
+{
+    return _poly_set_capacity(P, P->deg + 1);
+}
+
+/* Reallocate memory for P (e.g. for setting a new coef. higher than previous degree)
+ * The capacity grows geometrically, so that increasing the degree one
+ * coefficient at a time costs amortized O(1) per coefficient.
+ *
+ * /!\ This function assumes poly_set_coef will be called afterwards
+ * so that the degree gets properly computed.
+ */
+int
+poly_realloc(Polynomial *P, int deg)
+{
+    if (!poly_make_writable(P)) {
+        return 0;
+    }
+    if (deg + 1 > P->capacity
+            &&
+        !poly_reserve(P, MAX(deg + 1, 2 * P->capacity))) {
+        return 0;
+    }
+    if (deg > P->deg) {
+        memset(P->coef + P->deg + 1, 0, (deg - P->deg) * sizeof(Complex));
+    }
+    P->deg = deg;
+    return 1;
+}
+
+int
+poly_equal(Polynomial *P, Polynomial *Q)
+{
+    int i;
+    if (P == Q) return 1;
+    if (P->deg != Q->deg) return 0;
+    if (P->coef == Q->coef) return 1;   /* Shared coefficients */
+    for (i = 0; i <= P->deg; ++i) {
+        if (P->coef[i].real != Q->coef[i].real
+                ||
+            P->coef[i].imag != Q->coef[i].imag) {
+            return 0;
+        }
     }
     return 1;
 }
@@ -205,8 +978,10 @@ poly_equal(Polynomial *P, Polynomial *Q)
 #define STR_J                   "j"
 #define STR_TRUNCATED           "... [truncated]"
 
-char*
-poly_to_string(Polynomial *P)
+/* The basis element of degree i > 0 is printed with format "one" for i = 1
+ * and "power" (given i) otherwise. */
+static char*
+_poly_to_string(Polynomial *P, const char *one, const char *power)
 {
     if (P->deg == -1) {
         return strdup("0");
@@ -252,14 +1027,16 @@ poly_to_string(Polynomial *P)
                                    i == 0 ? "%g%+g%s" : "(%g%+g%s)",
                                    re, im, STR_J);
             }
+            if (i > 0 && add_mult_sign) {
+                offset += snprintf(buffer + offset,
+                                   BUFFER_AVAILABLE(buffer, offset), " * ");
+            }
             if (i == 1) {
                 offset += snprintf(buffer + offset,
-                                   BUFFER_AVAILABLE(buffer, offset),
-                                   "%s", add_mult_sign ? " * " STR_UNKOWN : STR_UNKOWN);
+                                   BUFFER_AVAILABLE(buffer, offset), "%s", one);
             } else if (i > 1) {
                 offset += snprintf(buffer + offset,
-                                   BUFFER_AVAILABLE(buffer, offset),
-                                   "%s**%d", add_mult_sign ? " * " STR_UNKOWN : STR_UNKOWN, i);
+                                   BUFFER_AVAILABLE(buffer, offset), power, i);
             }
             if (offset > (int)sizeof(buffer)) {
                 memcpy(buffer + sizeof(buffer) - strlen(STR_TRUNCATED) - 1,
@@ -271,18 +1048,350 @@ poly_to_string(Polynomial *P)
     }
 }
 
+char*
+poly_to_string(Polynomial *P)
+{
+    return _poly_to_string(P, STR_UNKOWN, STR_UNKOWN "**%d");
+}
+
 /* Polynomial evaluation at a given point using Horner's method.
  * Performs O(deg P) operations (naïve approach is quadratic).
  * See http://en.wikipedia.org/wiki/Horner%27s_method */
 Complex
 poly_eval(Polynomial *P, Complex c)
 {
-    Complex result = CZero;
-    int i;
-    for (i = P->deg; i >= 0; --i) {
-        result = complex_add(complex_mult(result, c), P->coef[i]);
+    return kernels->horner(P->coef, P->deg, c);
+}
+
+/**
+ * Fast multiplication
+ *
+ * The products work on plain coefficients arrays and compute the band of
+ * coefficients lo <= k < hi of a * b, so that truncated (low, high) and middle
+ * products only pay for what they return.
+ * Schoolbook is used for short operands, Karatsuba for medium ones and a
+ * complex FFT for long ones. The latter two have normwise error bounds: small
+ * coefficients next to large ones are not computed to full relative accuracy.
+ */
+
+#define KARATSUBA_THRESHOLD     64      /* Length of the shortest operand */
+#define FFT_THRESHOLD           512
+
+/* Upper bound of the scratch memory needed by the products of operands of
+ * lengths na and nb, used as arena hint. */
+#define MUL_SCRATCH_HINT(na, nb)    (((na) < KARATSUBA_THRESHOLD            \
+                                    || (nb) < KARATSUBA_THRESHOLD)          \
+                                    ? 0 : 8 * ((na) + (nb)))
+
+static const double PI = 3.14159265358979323846;
+
+/* r[k - lo] += a[i] * b[j] for i + j = k, lo <= k < hi */
+static void
+_mul_band_schoolbook(Complex *r, const Complex *a, int na,
+                     const Complex *b, int nb, int lo, int hi)
+{
+    int i, j0, j1;
+    for (i = 0; i < na && i < hi; ++i) {
+        if (complex_iszero(a[i])) {
+            continue;
+        }
+        j0 = MAX(0, lo - i);
+        j1 = MIN(nb, hi - i);
+        if (j0 < j1) {
+            kernels->axpy(r + i + j0 - lo, b + j0, a[i], j1 - j0);
+        }
+    }
+}
+
+/* r[0 .. 2n - 2] = a * b, for a and b of length n */
+static int
+_mul_karatsuba(Complex *r, const Complex *a, const Complex *b, int n,
+               PolyArena *arena)
+{
+    int h, l, ret;
+    PolyArenaMark mark;
+    Complex *sa, *sb, *z1;
+    if (n < KARATSUBA_THRESHOLD) {
+        memset(r, 0, (2 * n - 1) * sizeof(Complex));
+        _mul_band_schoolbook(r, a, n, b, n, 0, 2 * n - 1);
+        return 1;
+    }
+    /* a = a0 + X**h a1, b = b0 + X**h b1
+     * a * b = z0 + X**h (z1 - z0 - z2) + X**2h z2
+     * with z0 = a0 b0, z2 = a1 b1 and z1 = (a0 + a1) (b0 + b1) */
+    h = (n + 1) / 2;
+    l = n - h;
+    mark = poly_arena_mark(arena);
+    if ((sa = poly_arena_alloc(arena, 4 * h - 1)) == NULL) {
+        return 0;
+    }
+    sb = sa + h;
+    z1 = sb + h;
+    kernels->add(sa, a, a + h, l);
+    kernels->add(sb, b, b + h, l);
+    if (l < h) {
+        sa[h - 1] = a[h - 1];
+        sb[h - 1] = b[h - 1];
+    }
+    ret = _mul_karatsuba(r, a, b, h, arena)
+            &&
+          _mul_karatsuba(r + 2 * h, a + h, b + h, l, arena)
+            &&
+          _mul_karatsuba(z1, sa, sb, h, arena);
+    if (ret) {
+        r[2 * h - 1] = CZero;
+        kernels->sub(z1, z1, r, 2 * h - 1);
+        kernels->sub(z1, z1, r + 2 * h, 2 * l - 1);
+        kernels->add(r + h, r + h, z1, 2 * h - 1);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0 .. na + nb - 2] = a * b, unbalanced operands are cut in balanced
+ * blocks. */
+static int
+_mul_full(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+          PolyArena *arena)
+{
+    const Complex *c;
+    Complex *t;
+    int i, m, ret = 1;
+    PolyArenaMark mark;
+    if (na < nb) {
+        c = a; a = b; b = c;
+        i = na; na = nb; nb = i;
+    }
+    if (nb < KARATSUBA_THRESHOLD) {
+        memset(r, 0, (na + nb - 1) * sizeof(Complex));
+        _mul_band_schoolbook(r, a, na, b, nb, 0, na + nb - 1);
+        return 1;
+    }
+    if (na == nb) {
+        return _mul_karatsuba(r, a, b, nb, arena);
+    }
+    mark = poly_arena_mark(arena);
+    if ((t = poly_arena_alloc(arena, 2 * nb - 1)) == NULL) {
+        return 0;
+    }
+    memset(r, 0, (na + nb - 1) * sizeof(Complex));
+    for (i = 0; ret && i < na; i += nb) {
+        m = MIN(nb, na - i);
+        ret = (m == nb) ? _mul_karatsuba(t, a + i, b, nb, arena)
+                        : _mul_full(t, b, nb, a + i, m, arena);
+        kernels->add(r + i, r + i, t, m + nb - 1);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0 .. n - 1] = a * b mod X**n, for a and b of length n.
+ * Mulders' short product: a full product of the first 0.7 n coefficients,
+ * and two short products of the remaining 0.3 n. */
+static int
+_mul_low_karatsuba(Complex *r, const Complex *a, const Complex *b, int n,
+                   PolyArena *arena)
+{
+    int k, l, ret;
+    PolyArenaMark mark;
+    Complex *t, *u;
+    if (n < KARATSUBA_THRESHOLD) {
+        memset(r, 0, n * sizeof(Complex));
+        _mul_band_schoolbook(r, a, n, b, n, 0, n);
+        return 1;
+    }
+    k = n - 3 * n / 10;
+    l = n - k;
+    mark = poly_arena_mark(arena);
+    if ((t = poly_arena_alloc(arena, 2 * k - 1 + l)) == NULL) {
+        return 0;
+    }
+    u = t + 2 * k - 1;
+    if ((ret = _mul_karatsuba(t, a, b, k, arena))) {
+        memcpy(r, t, n * sizeof(Complex));
+    }
+    if (ret && (ret = _mul_low_karatsuba(u, a, b + k, l, arena))) {
+        kernels->add(r + k, r + k, u, l);
+    }
+    if (ret && (ret = _mul_low_karatsuba(u, a + k, b, l, arena))) {
+        kernels->add(r + k, r + k, u, l);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* Copy the n first coefficients of a (of length na), or of a reversed, into
+ * "dest", padded with zeros. */
+static void
+_mul_operand(Complex *dest, const Complex *a, int na, int n, int reverse)
+{
+    int i, m = MIN(na, n);
+    if (reverse) {
+        for (i = 0; i < m; ++i) {
+            dest[i] = a[na - 1 - i];
+        }
+    } else {
+        memcpy(dest, a, m * sizeof(Complex));
+    }
+    memset(dest + m, 0, (n - m) * sizeof(Complex));
+}
+
+/* Band of a Karatsuba product: low products are short products, high
+ * products are short products of the reversed operands, and middle ones are
+ * sliced from a low product. */
+static int
+_mul_band_karatsuba(Complex *r, const Complex *a, int na,
+                    const Complex *b, int nb, int lo, int hi,
+                    PolyArena *arena)
+{
+    int L = na + nb - 1, reverse = (hi == L), n, i, ret;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *t, *pa, *pb;
+    if (lo == 0 && hi == L) {
+        return _mul_full(r, a, na, b, nb, arena);
+    }
+    n = reverse ? L - lo : hi;
+    if (2 * MIN(na, nb) < n) {
+        /* Unbalanced: a short product would mostly multiply zeros */
+        if ((t = poly_arena_alloc(arena, L)) == NULL) {
+            return 0;
+        }
+        if ((ret = _mul_full(t, a, na, b, nb, arena))) {
+            memcpy(r, t + lo, (hi - lo) * sizeof(Complex));
+        }
+        poly_arena_rewind(arena, mark);
+        return ret;
+    }
+    if ((t = poly_arena_alloc(arena, 3 * n)) == NULL) {
+        return 0;
+    }
+    pa = t + n;
+    pb = pa + n;
+    _mul_operand(pa, a, na, n, reverse);
+    _mul_operand(pb, b, nb, n, reverse);
+    if ((ret = _mul_low_karatsuba(t, pa, pb, n, arena))) {
+        if (reverse) {
+            for (i = 0; i < n; ++i) {
+                r[i] = t[n - 1 - i];
+            }
+        } else {
+            memcpy(r, t + lo, (hi - lo) * sizeof(Complex));
+        }
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* In place radix-2 FFT of the n = 2**k points of x, given the twiddle
+ * factors w[j] = exp(-2i pi j / n) for j < n / 2.
+ * The inverse transform is not normalized. */
+static void
+_fft(Complex *x, int n, const Complex *w, int inverse)
+{
+    int i, j, k, len, half, step;
+    Complex t, u, v;
+    for (i = 1, j = 0; i < n; ++i) {
+        for (k = n >> 1; j & k; k >>= 1) {
+            j ^= k;
+        }
+        j ^= k;
+        if (i < j) {
+            t = x[i]; x[i] = x[j]; x[j] = t;
+        }
+    }
+    for (len = 2; len <= n; len <<= 1) {
+        half = len >> 1;
+        step = n / len;
+        for (i = 0; i < n; i += len) {
+            for (j = 0; j < half; ++j) {
+                t = w[j * step];
+                if (inverse) {
+                    t.imag = -t.imag;
+                }
+                u = x[i + j];
+                v = complex_mult(x[i + j + half], t);
+                x[i + j] = complex_add(u, v);
+                x[i + j + half] = complex_sub(u, v);
+            }
+        }
+    }
+}
+
+/* Band of a product computed by cyclic convolution.
+ * Modulo X**n - 1 the coefficient k receives the coefficients k + n and
+ * k - n of the product: they do not exist, hence do not alias the band,
+ * when n >= hi and n >= L - lo. This is what makes middle products cheaper
+ * than full ones. */
+static int
+_mul_band_fft(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+              int lo, int hi, PolyArena *arena)
+{
+    int L = na + nb - 1, n = 1, i;
+    double scale;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *x, *y, *w;
+    while (n < hi || n < L - lo) {
+        n <<= 1;
+    }
+    if ((x = poly_arena_alloc(arena, 2 * n + n / 2 + 1)) == NULL) {
+        return 0;
+    }
+    y = x + n;
+    w = y + n;
+    for (i = 0; i < n / 2; ++i) {
+        w[i].real = cos(2 * PI * i / n);
+        w[i].imag = -sin(2 * PI * i / n);
+    }
+    _mul_operand(x, a, na, n, 0);
+    _mul_operand(y, b, nb, n, 0);
+    _fft(x, n, w, 0);
+    _fft(y, n, w, 0);
+    for (i = 0; i < n; ++i) {
+        x[i] = complex_mult(x[i], y[i]);
+    }
+    _fft(x, n, w, 1);
+    scale = 1. / n;
+    for (i = lo; i < hi; ++i) {
+        r[i - lo].real = x[i].real * scale;
+        r[i - lo].imag = x[i].imag * scale;
+    }
+    poly_arena_rewind(arena, mark);
+    return 1;
+}
+
+/* r[k - lo] = coefficient k of a * b, for lo <= k < hi.
+ * r does not overlap a or b, its hi - lo coefficients need not be
+ * initialized. */
+static int
+_mul_band(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+          int lo, int hi, int algorithm, PolyArena *arena)
+{
+    int L, m;
+    na = MIN(na, hi);   /* Higher coefficients do not contribute */
+    nb = MIN(nb, hi);
+    L = na + nb - 1;
+    if (L < hi) {
+        memset(r + MAX(L - lo, 0), 0, (hi - MAX(L, lo)) * sizeof(Complex));
+        hi = L;
+    }
+    if (lo >= hi) {
+        return 1;
+    }
+    if (algorithm == POLY_MUL_AUTO) {
+        m = MIN(na, nb);
+        algorithm = (m < KARATSUBA_THRESHOLD) ? POLY_MUL_SCHOOLBOOK
+                  : (m < FFT_THRESHOLD) ? POLY_MUL_KARATSUBA : POLY_MUL_FFT;
+    }
+    switch (algorithm) {
+    case POLY_MUL_KARATSUBA:
+        return _mul_band_karatsuba(r, a, na, b, nb, lo, hi, arena);
+    case POLY_MUL_FFT:
+        return _mul_band_fft(r, a, na, b, nb, lo, hi, arena);
+    default:
+        memset(r, 0, (hi - lo) * sizeof(Complex));
+        _mul_band_schoolbook(r, a, na, b, nb, lo, hi);
+        return 1;
     }
-    return result;
 }
 
 /**
@@ -295,29 +1404,60 @@ poly_eval(Polynomial *P, Complex c)
  * It is up to the operators to perform this initialization when relevant.
  */
 
-/* Copy polynomial pointed by A to the location pointed by P */
+/* Copy polynomial pointed by A to the location pointed by P.
+ * Coefficients are shared until either polynomial is modified, so this is
+ * O(1) unless A does not own its coefficients (e.g. arena temporaries) or
+ * they are pinned. */
 int
 poly_copy(Polynomial *A, Polynomial *P)
 {
+    if (A->coef != NULL && !(A->flags & (POLY_BORROWED | POLY_PINNED))) {
+        *P = *A;
+        Atomic_Incr(&Coef_Header(P->coef)->refcnt);
+        return 1;
+    }
     if (!poly_init(P, A->deg)) {
         return 0;
     }
-    memcpy(P->coef, A->coef, (A->deg + 1) * sizeof(Complex));
+    if (A->deg >= 0) {
+        memcpy(P->coef, A->coef, (A->deg + 1) * sizeof(Complex));
+    }
     P->bloom = A->bloom;
     return 1;
 }
 
+/* R = A + B (or A - B), the coefficients of R may be those of A or B,
+ * provided they can hold max(deg A, deg B) + 1 coefficients. */
+static void
+_poly_add_into(Polynomial *A, Polynomial *B, Polynomial *R, int substract)
+{
+    int n = MIN(A->deg, B->deg) + 1, i;
+    if (substract) {
+        kernels->sub(R->coef, A->coef, B->coef, n);
+    } else {
+        kernels->add(R->coef, A->coef, B->coef, n);
+    }
+    if (A->deg >= n && R->coef != A->coef) {
+        memcpy(R->coef + n, A->coef + n, (A->deg + 1 - n) * sizeof(Complex));
+    } else if (B->deg >= n) {
+        if (substract) {
+            for (i = n; i <= B->deg; ++i) R->coef[i] = complex_neg(B->coef[i]);
+        } else if (R->coef != B->coef) {
+            memcpy(R->coef + n, B->coef + n, (B->deg + 1 - n) * sizeof(Complex));
+        }
+    }
+    R->deg = MAX(A->deg, B->deg);
+    R->bloom = A->bloom | B->bloom;
+    Poly_ResizeDown(R);
+}
+
 int
 poly_add(Polynomial *A, Polynomial *B, Polynomial *R)
 {
     if (!poly_init(R, MAX(A->deg, B->deg))) {
         return 0;
     }
-    int i;
-    for (i = 0; i <= MAX(A->deg, B->deg); ++i) {
-        _poly_set_coef(R, i, complex_add(Poly_GetCoef(A, i), Poly_GetCoef(B, i)));
-    }
-    Poly_ResizeDown(R);
+    _poly_add_into(A, B, R, 0);
     return 1;
 }
 
@@ -327,21 +1467,17 @@ poly_sub(Polynomial *A, Polynomial *B, Polynomial *R)
     if (!poly_init(R, MAX(A->deg, B->deg))) {
         return 0;
     }
-    int i;
-    for (i = 0; i <= MAX(A->deg, B->deg); ++i) {
-        _poly_set_coef(R, i, complex_sub(Poly_GetCoef(A, i), Poly_GetCoef(B, i)));
-    }
-    Poly_ResizeDown(R);
+    _poly_add_into(A, B, R, 1);
     return 1;
 }
 
 int
 poly_neg(Polynomial *A, Polynomial *Q)
 {
+    int i;
     if (!poly_init(Q, A->deg)) {
         return 0;
     }
-    int i;
     for (i = 0; i <= A->deg; ++i) {
         _poly_set_coef(Q, i, complex_neg(A->coef[i]));
     }
@@ -358,148 +1494,684 @@ poly_scal_multiply(Polynomial *A, Complex c, Polynomial *R)
     if (!poly_init(R, A->deg)) {
         return 0;
     }
+    kernels->scale(R->coef, A->coef, c, A->deg + 1);
+    R->bloom = A->bloom;
+    return 1;
+}
+
+/* Monomials c X**k are recognized by their bloom filter first: only the
+ * indices k mod 32 can be nonzero when it is exactly the bit of the degree.
+ * A stale filter can only hide a monomial, which is then multiplied the
+ * general way. */
+static inline int
+_poly_is_monomial(Polynomial *P)
+{
     int i;
-    for (i = 0; i <= A->deg; ++i) {
-        if (A->bloom & Poly_BloomMask(i)) {
-            _poly_set_coef(R, i, complex_mult(Poly_GetCoef(A, i), c));
+    if (P->deg < 0 || P->bloom != (uint32_t)Poly_BloomMask(P->deg)) {
+        return 0;
+    }
+    for (i = P->deg & 0x1f; i < P->deg; i += 32) {
+        if (!complex_iszero(P->coef[i])) {
+            return 0;
         }
     }
     return 1;
 }
 
-int
-poly_multiply(Polynomial *A, Polynomial *B, Polynomial *R)
+/* Bloom filter of X**k P */
+#define Poly_BloomShift(bloom, k)                                       \
+    ((((k) & 0x1f) == 0) ? (bloom)                                      \
+     : (uint32_t)(((bloom) << ((k) & 0x1f)) | ((bloom) >> (32 - ((k) & 0x1f)))))
+
+/* r[i - lo] = coefficient i of c X**k a, for lo <= i < hi: a copy (or a
+ * scaling) and zeros, instead of a product. */
+static void
+_mul_band_monomial(Complex *r, const Complex *a, int na, Complex c, int k,
+                   int lo, int hi)
+{
+    int start = MAX(lo, k), end = MIN(hi, k + na);
+    if (start >= end) {
+        memset(r, 0, (hi - lo) * sizeof(Complex));
+        return;
+    }
+    memset(r, 0, (start - lo) * sizeof(Complex));
+    if (c.real == 1. && c.imag == 0.) {
+        memcpy(r + start - lo, a + start - k, (end - start) * sizeof(Complex));
+    } else {
+        kernels->scale(r + start - lo, a + start - k, c, end - start);
+    }
+    memset(r + end - lo, 0, (hi - end) * sizeof(Complex));
+}
+
+/* Product of A and B into R, whose storage must be able to hold
+ * deg A + deg B + 1 coefficients and must not overlap A or B.
+ * Scratch memory, if any, is drawn from the arena. */
+static int
+_poly_multiply_into(Polynomial *A, Polynomial *B, Polynomial *R,
+                    PolyArena *arena)
 {
-    // TODO: implement faster algo
+    R->bloom = 0;
     if (A->deg == -1 || B->deg == -1) {
-        poly_init(R, -1);
+        R->deg = -1;
         return 1;
     }
-    if (!poly_init(R, A->deg + B->deg)) {
-        return 0;
+    R->deg = A->deg + B->deg;
+    if (_poly_is_monomial(A)) {
+        Polynomial *T = A; A = B; B = T;
     }
-    int i, j;
-    for (i = 0; i <= A->deg + B->deg; ++i) {
-        for (j = 0; j <= i; ++j) {
-            if ((A->bloom & Poly_BloomMask(j)) && (B->bloom & Poly_BloomMask(i - j))) {
-                _poly_incr_coef(R, i, complex_mult(Poly_GetCoef(A, j), Poly_GetCoef(B, i - j)));
-            }
-        }
+    if (_poly_is_monomial(B)) {
+        _mul_band_monomial(R->coef, A->coef, A->deg + 1, B->coef[B->deg],
+                           B->deg, 0, R->deg + 1);
+        R->bloom = Poly_BloomShift(A->bloom, B->deg);
+        Poly_ResizeDown(R);     /* If the scaling underflows */
+        return 1;
+    }
+    if (!_mul_band(R->coef, A->coef, A->deg + 1, B->coef, B->deg + 1,
+                   0, R->deg + 1, POLY_MUL_AUTO, arena)) {
+        return 0;
     }
+    _poly_reset_bloom(R);
     return 1;
 }
 
+/* Copy the coefficients of A into P, whose storage must be large enough */
+static void
+_poly_assign(Polynomial *A, Polynomial *P)
+{
+    if (A->deg >= 0) {
+        memcpy(P->coef, A->coef, (A->deg + 1) * sizeof(Complex));
+    }
+    P->deg = A->deg;
+    P->bloom = A->bloom;
+}
+
 int
-poly_pow(Polynomial *A, unsigned int n, Polynomial *R)
+poly_multiply(Polynomial *A, Polynomial *B, Polynomial *R)
 {
-    if (n == 0) {
-        int failure = 0;
-        Poly_InitConst(R, ((Complex){1, 0}), failure);
-        return !failure;
+    return poly_mul_middle(A, B, 0, INT_MAX, POLY_MUL_AUTO, R);
+}
+
+/* Coefficients lo to hi - 1 of A * B, that is (A * B mod X**hi) / X**lo.
+ * Only the requested band is computed, which saves about half of the work
+ * for low and high products. */
+int
+poly_mul_middle(Polynomial *A, Polynomial *B, int lo, int hi, int algorithm,
+                Polynomial *R)
+{
+    int ret;
+    PolyArena arena;
+    lo = MAX(lo, 0);
+    if (A->deg == -1 || B->deg == -1) {
+        hi = lo;
     }
-    if (n == 1) {
-        return poly_copy(A, R);
+    hi = MIN(hi, A->deg + B->deg + 1);
+    if (hi <= lo) {
+        poly_init(R, -1);
+        return 1;
     }
-    Polynomial T;
-    if (!poly_multiply(A, A, &T)) return 0;
-    if (!poly_pow(&T, n >> 1, R)) {
-        poly_free(&T);
+    if (!poly_init(R, hi - lo - 1)) {
         return 0;
     }
-    poly_free(&T);
-    if (n & 1) {
-        if (!poly_multiply(R, A, &T)) {
-            poly_free(R);
-            return 0;
-        }
+    if (_poly_is_monomial(A)) {
+        Polynomial *T = A; A = B; B = T;
+    }
+    if (_poly_is_monomial(B)) {
+        _mul_band_monomial(R->coef, A->coef, A->deg + 1, B->coef[B->deg],
+                           B->deg, lo, hi);
+        R->bloom = Poly_BloomShift(A->bloom, B->deg - lo);
+        Poly_ResizeDown(R);
+        return 1;
+    }
+    poly_arena_init(&arena, MUL_SCRATCH_HINT(MIN(A->deg + 1, hi), MIN(B->deg + 1, hi)));
+    ret = _mul_band(R->coef, A->coef, A->deg + 1, B->coef, B->deg + 1,
+                    lo, hi, algorithm, &arena);
+    poly_arena_release(&arena);
+    if (!ret) {
         poly_free(R);
-        *R = T;
+        return 0;
     }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
     return 1;
 }
 
+/* Low product: A * B mod X**n */
 int
-poly_derive(Polynomial *A, unsigned int n, Polynomial *R)
+poly_mul_low(Polynomial *A, Polynomial *B, int n, int algorithm, Polynomial *R)
 {
-    if (!poly_init(R, MAX(-1, A->deg - (int)n))) {
-        return 0;
-    }
-    int i, j, multiplier;
-    for (i = 0; i <= R->deg; ++i) {
-        multiplier = 1;
-        for (j = i; j < i + (int)n; ++j) multiplier *= j + 1;
-        _poly_set_coef(R, i, complex_mult((Complex){(double)multiplier, 0}, A->coef[j]));
-    }
-    return 1;
+    return poly_mul_middle(A, B, 0, n, algorithm, R);
 }
 
+/* High product: the terms of degree n and above of A * B, divided by X**n */
 int
-poly_integrate(Polynomial *A, unsigned int n, Polynomial *R)
+poly_mul_high(Polynomial *A, Polynomial *B, int n, int algorithm, Polynomial *R)
 {
-    if (!poly_init(R, (A->deg == -1) ? -1 : A->deg + (int)n)) {
-        return 0;
+    return poly_mul_middle(A, B, n, INT_MAX, algorithm, R);
+}
+
+/* r[0 .. na + nb - 2] += c * a * b, r must not overlap a or b.
+ * When the shorter operand is below KARATSUBA_THRESHOLD, the product is
+ * accumulated directly by the mul_acc kernel. Otherwise it is computed into
+ * scratch memory from the arena, then accumulated. */
+static int
+_mul_accumulate(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+                Complex c, PolyArena *arena)
+{
+    PolyArenaMark mark;
+    Complex *t;
+    int i;
+    if (na > nb) {
+        const Complex *s = a; a = b; b = s;
+        i = na; na = nb; nb = i;
     }
-    int i, j, divisor;
-    for (i = n; i <= R->deg; ++i) {
-        divisor = 1;
-        for (j = i; j > i - (int)n; --j) divisor *= j;
-        _poly_set_coef(R, i, complex_div(A->coef[j], (Complex){(double)divisor, 0}));
+    if (na < KARATSUBA_THRESHOLD) {
+        kernels->mul_acc(r, a, na, b, nb, c);
+        return 1;
+    }
+    mark = poly_arena_mark(arena);
+    if ((t = poly_arena_alloc(arena, na + nb - 1)) == NULL
+            ||
+        !_mul_band(t, a, na, b, nb, 0, na + nb - 1, POLY_MUL_AUTO, arena)) {
+        return 0;
     }
+    kernels->axpy(r, t, c, na + nb - 1);
+    poly_arena_rewind(arena, mark);
     return 1;
 }
 
-/* Euclidean division of A by B.
- * If B is not zero, the resulting polynomials Q and R are defined by:
- *      A = B * Q + R, deg R < deg B
- * If B is zero, the operation is undefined and returns -1.
- */
+/* Sum of products: R = c_1 A_1 B_1 + ... + c_n A_n B_n, where B_k may be NULL
+ * for a term c_k A_k. All the terms are accumulated into the coefficients of
+ * R: no temporary polynomial is created for the partial sums, nor for the
+ * products by monomials or short operands. R must not be an operand. */
 int
-poly_div(Polynomial *A, Polynomial *B, Polynomial *Q, Polynomial *R)
+poly_sum_of_products(const PolyTerm *terms, int n, Polynomial *R)
 {
-    if (B->deg == -1) {
-        return -1;  // Division by zero
+    Polynomial *A, *B;
+    PolyArena arena;
+    long long deg = -1;
+    int k, hint = 0, ret = 1;
+    for (k = 0; k < n; ++k) {
+        A = terms[k].A;
+        B = terms[k].B;
+        if (A->deg == -1 || (B != NULL && B->deg == -1)) {
+            continue;
+        }
+        if (B == NULL) {
+            deg = (A->deg > deg) ? A->deg : deg;
+        } else {
+            deg = ((long long)A->deg + B->deg > deg) ? (long long)A->deg + B->deg : deg;
+            hint = MAX(hint, MUL_SCRATCH_HINT(A->deg + 1, B->deg + 1));
+        }
     }
-    Complex B_leadcoef = Poly_LeadCoef(B);
-    Polynomial T1, T2;  // Used as buffers
+    if (deg >= INT_MAX || !poly_init(R, (int)deg)) {
+        return 0;
+    }
+    poly_arena_init(&arena, hint);
+    for (k = 0; k < n && ret; ++k) {
+        Complex c = terms[k].c;
+        A = terms[k].A;
+        B = terms[k].B;
+        if (A->deg == -1 || (B != NULL && B->deg == -1) || complex_iszero(c)) {
+            continue;
+        }
+        if (B == NULL) {
+            if (c.real == 1. && c.imag == 0.) {
+                kernels->add(R->coef, R->coef, A->coef, A->deg + 1);
+            } else if (c.real == -1. && c.imag == 0.) {
+                kernels->sub(R->coef, R->coef, A->coef, A->deg + 1);
+            } else {
+                kernels->axpy(R->coef, A->coef, c, A->deg + 1);
+            }
+            continue;
+        }
+        if (_poly_is_monomial(A)) {
+            Polynomial *T = A; A = B; B = T;
+        }
+        if (_poly_is_monomial(B)) {
+            kernels->axpy(R->coef + B->deg, A->coef,
+                          complex_mult(c, B->coef[B->deg]), A->deg + 1);
+        } else {
+            ret = _mul_accumulate(R->coef, A->coef, A->deg + 1,
+                                  B->coef, B->deg + 1, c, &arena);
+        }
+    }
+    poly_arena_release(&arena);
+    if (!ret) {
+        poly_free(R);
+        return 0;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
 
-    /* Polynomials coefficients MUST be initialized. */
-    if (Q != NULL) {
-        poly_init(Q, -1);
+/* Fused multiply-add: R = A * B + C, with a single result buffer */
+int
+poly_fma(Polynomial *A, Polynomial *B, Polynomial *C, Polynomial *R)
+{
+    PolyTerm terms[2];
+    terms[0].c = COne;
+    terms[0].A = A;
+    terms[0].B = B;
+    terms[1].c = COne;
+    terms[1].A = C;
+    terms[1].B = NULL;
+    return poly_sum_of_products(terms, 2, R);
+}
+
+/* Powers of bases with at most MILLER_THRESHOLD non zero coefficients (the
+ * lowest one excluded) and exponents from MILLER_MIN_EXPONENT on go through
+ * Miller's recurrence, the other ones through binary exponentiation. */
+#define MILLER_THRESHOLD        16
+#define MILLER_MIN_EXPONENT     16
+
+/* Scale z so that its largest component is in [0.5, 1), the exponent of the
+ * scaling factor is added to "e". */
+static inline Complex
+_complex_normalize(Complex z, long long *e)
+{
+    int p;
+    (void)frexp(fmax(fabs(z.real), fabs(z.imag)), &p);
+    z.real = ldexp(z.real, -p);
+    z.imag = ldexp(z.imag, -p);
+    *e += p;
+    return z;
+}
+
+/* z**n = r * 2**e, which may be far beyond the range of a double */
+static Complex
+_complex_ipow_scaled(Complex z, unsigned int n, long long *e)
+{
+    Complex r = COne;
+    long long ze = 0, p;
+    *e = 0;
+    z = _complex_normalize(z, &ze);
+    while (n != 0) {
+        if (n & 1) {
+            r = _complex_normalize(complex_mult(r, z), e);
+            *e += ze;
+        }
+        if ((n >>= 1) != 0) {
+            p = 0;
+            z = _complex_normalize(complex_mult(z, z), &p);
+            ze = 2 * ze + p;
+        }
+    }
+    return r;
+}
+
+/* J.C.P. Miller's recurrence for the coefficients q of B**n, with b0 != 0:
+ *      k b0 q[k] = sum((n + 1) i - k) b[i] q[k - i], 1 <= i <= min(k, deg B)
+ * which costs O(deg(B**n) * nnz(B)) operations and a single buffer.
+ * The coefficients typically span a range much wider than a double's: they
+ * are computed for q[0] = 1 with a binary exponent each, then scaled by
+ * b0**n.
+ * The terms of the sum have opposite signs for k > (n + 1) i, and the
+ * cancellation grows with k: each end of B**n is computed from the matching
+ * end of B (reversing B reverses its powers), and the recurrence is only used
+ * when the coefficients of B share a phase, possibly once X is changed into
+ * -X, as then the terms are dominated by the ones of the same sign. */
+
+/* Sign (1 or -1) of X in B(sign X) if its coefficients then share a phase,
+ * 0 if they do not. */
+static int
+_miller_sign(const Complex *a, int d)
+{
+    int sign, i;
+    Complex w;
+    for (sign = 1; sign >= -1; sign -= 2) {
+        for (i = 1; i <= d; ++i) {
+            if (complex_iszero(a[i])) {
+                continue;
+            }
+            /* a[i] conj(a[0]) must be a positive multiple of sign**i */
+            w = complex_mult(a[i], (Complex){a[0].real, -a[0].imag});
+            if (sign == -1 && (i & 1)) {
+                w.real = -w.real;
+                w.imag = -w.imag;
+            }
+            if (!(w.real > 0. && fabs(w.imag) <= 16 * DBL_EPSILON * w.real)) {
+                break;
+            }
+        }
+        if (i > d) {
+            return sign;
+        }
+    }
+    return 0;
+}
+
+/* The coefficients q[0], q[dir], ..., q[(count - 1) dir] of B**n, where
+ * B = b[0] + b[dir] X + ... + b[d dir] X**d: dir is 1 for the lower end of
+ * the base and its power, -1 for their upper end. "ex" holds the binary
+ * exponents, indexed as q. */
+static void
+_miller_recurrence(const Complex *b, int d, int dir, unsigned int n,
+                   Complex *q, int *ex, int count)
+{
+    int idx[MILLER_THRESHOLD], nnz = 0, i, k, t;
+    long long E, E0, e;
+    Complex c[MILLER_THRESHOLD], b0 = b[0], s, w, M;
+    double f;
+    for (i = 1; i <= d; ++i) {
+        if (!complex_iszero(b[i * dir])) {
+            idx[nnz] = i;
+            c[nnz++] = b[i * dir];
+        }
+    }
+    q[0] = COne;
+    ex[0] = 0;
+    for (k = 1; k < count; ++k) {
+        /* Common exponent of the terms, the largest one */
+        E = ex[(k - 1) * dir];
+        for (t = 0; t < nnz && idx[t] <= k; ++t) {
+            E = MAX(E, ex[(k - idx[t]) * dir]);
+        }
+        s = CZero;
+        for (t = 0; t < nnz && idx[t] <= k; ++t) {
+            i = idx[t];
+            f = (double)(n + 1) * i - k;
+            if (ex[(k - i) * dir] != E) {
+                f = ldexp(f, ex[(k - i) * dir] - (int)E);
+            }
+            w = complex_mult(c[t], q[(k - i) * dir]);
+            s.real += f * w.real;
+            s.imag += f * w.imag;
+        }
+        s = complex_div(s, (Complex){k * b0.real, k * b0.imag});
+        if (!complex_iszero(s)) {
+            s = _complex_normalize(s, &E);
+        }
+        q[k * dir] = s;
+        ex[k * dir] = (int)E;
+    }
+    M = _complex_ipow_scaled(b0, n, &E0);
+    for (k = 0; k < count; ++k) {
+        e = ex[k * dir] + E0;
+        e = (e > 4096) ? 4096 : (e < -4096) ? -4096 : e;
+        w = complex_mult(q[k * dir], M);
+        q[k * dir].real = ldexp(w.real, (int)e);
+        q[k * dir].imag = ldexp(w.imag, (int)e);
+    }
+}
+
+/* A**n through Miller's recurrence, provided the coefficients of A share a
+ * phase (see _miller_sign). Returns -1 if they do not. */
+static int
+_poly_pow_miller(Polynomial *A, unsigned int n, Polynomial *R)
+{
+    int v = poly_valuation(A), d = A->deg - v, N = d * (int)n;
+    int *ex;
+    Complex *q;
+    PolyArena arena;
+    if (_miller_sign(A->coef + v, d) == 0) {
+        return -1;
+    }
+    poly_arena_init(&arena, 0);
+    if ((ex = (int*)(void*)poly_arena_alloc(&arena, N / 4 + 1)) == NULL
+            ||
+        !poly_init(R, A->deg * (int)n)) {
+        poly_arena_release(&arena);
+        return 0;
+    }
+    q = R->coef + v * (int)n;
+    _miller_recurrence(A->coef + v, d, 1, n, q, ex, N / 2 + 1);
+    _miller_recurrence(A->coef + A->deg, d, -1, n, q + N, ex + N, N - N / 2);
+    poly_arena_release(&arena);
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+/* Number of non zero coefficients of P, counting at most up to "max" */
+static int
+_poly_count_nonzero(Polynomial *P, int max)
+{
+    int i, count = 0;
+    for (i = 0; i <= P->deg && count <= max; ++i) {
+        if (!complex_iszero(Poly_GetCoef(P, i))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/* Binary exponentiation, unless Miller's recurrence is faster.
+ * The successive squares and partial products all fit in deg A * n + 1
+ * coefficients, so they are drawn from a single arena allocation. */
+int
+poly_pow(Polynomial *A, unsigned int n, Polynomial *R)
+{
+    int deg, started = 0, ret;
+    PolyArena arena;
+    Polynomial S, T, U, Swap;  /* S = A**(2**k), U = partial product */
+    if (n == 0) {
+        int failure = 0;
+        Poly_InitConst(R, ((Complex){1, 0}), failure);
+        return !failure;
+    }
+    if (n == 1 || A->deg == -1) {
+        return poly_copy(A, R);
+    }
+    if ((long long)A->deg * n >= INT_MAX) {
+        return 0;
     }
-    poly_init(R, -1);
-    poly_init(&T1, -1);
-    poly_init(&T2, -1);
+    if (_poly_is_monomial(A)) {
+        /* (c X**k)**n = c**n X**(k n) */
+        long long e;
+        Complex c = _complex_ipow_scaled(A->coef[A->deg], n, &e);
+        e = MAX(-4096, MIN(4096, e));   /* Beyond the range of a double anyway */
+        c.real = ldexp(c.real, (int)e);
+        c.imag = ldexp(c.imag, (int)e);
+        if (!poly_init(R, A->deg * (int)n)) {
+            return 0;
+        }
+        memset(R->coef, 0, R->deg * sizeof(Complex));
+        R->coef[R->deg] = c;
+        R->bloom = Poly_BloomMask(R->deg);
+        Poly_ResizeDown(R);
+        return 1;
+    }
+    if (n >= MILLER_MIN_EXPONENT
+            && _poly_count_nonzero(A, MILLER_THRESHOLD + 1) <= MILLER_THRESHOLD + 1
+            && (ret = _poly_pow_miller(A, n, R)) != -1) {
+        return ret;
+    }
+    deg = A->deg * (int)n;
+    poly_arena_init(&arena, 3 * (deg + 1) + MUL_SCRATCH_HINT(deg + 1, deg + 1));
+    if (!poly_arena_poly(&arena, &S, deg)
+            ||
+        !poly_arena_poly(&arena, &T, deg)
+            ||
+        !poly_arena_poly(&arena, &U, deg)) {
+        poly_arena_release(&arena);
+        return 0;
+    }
+    _poly_assign(A, &S);
+    for (;;) {
+        if (n & 1) {
+            if (started) {
+                if (!_poly_multiply_into(&U, &S, &T, &arena)) {
+                    poly_arena_release(&arena);
+                    return 0;
+                }
+                Swap = U; U = T; T = Swap;
+            } else {
+                _poly_assign(&S, &U);
+                started = 1;
+            }
+        }
+        if ((n >>= 1) == 0) {
+            break;
+        }
+        if (!_poly_multiply_into(&S, &S, &T, &arena)) {
+            poly_arena_release(&arena);
+            return 0;
+        }
+        Swap = S; S = T; T = Swap;
+    }
+    ret = poly_copy(&U, R);
+    poly_arena_release(&arena);
+    return ret;
+}
 
-    if (Q != NULL && !poly_init(Q, A->deg)) goto error;
-    if (!poly_copy(A, R)) goto error;
+#define FACTORIAL_PASSES_ORDER  16  /* Up to this order, the factorial ratios
+                                     * are computed as plain products */
+#define FACTORIAL_BLOCK         256 /* Size of the table of factorial ratios */
+#define FACTORIAL_LANES         16  /* Products computed together, so that the
+                                     * multiplications do not wait on each other */
+
+/* r[j] *= (j + n)! / j! = (j + 1) (j + 2) ... (j + n), or r[j] /= (j + n)! / j!
+ * if "inverse" is set, for j < m.
+ * The factors are tabulated in blocks, then applied with one multiplication
+ * per coefficient (by the reciprocal when dividing). For small n, a block is
+ * built with n - 1 vectorizable multiplications per entry. Otherwise it is
+ * updated with the ratio f[j + 1] = f[j] (j + n + 1) / (j + 1), a serial chain
+ * but in O(m). Both are exact as long as the values are integers below 2**53.
+ * The factors grow with j: past the first one which overflows, nonzero parts
+ * overflow too and the others stay zero (rather than 0 * inf = NaN), or
+ * everything vanishes when dividing. */
+static void
+_scale_factorial_ratios(Complex *r, int m, unsigned int n, int inverse)
+{
+    double f[FACTORIAL_BLOCK], t[FACTORIAL_BLOCK], v = 1.;   /* t = j + 1 */
+    unsigned int k;
+    int b, i, j, l, s = m;
+    if (n > FACTORIAL_PASSES_ORDER) {
+        for (k = 2; k <= n && isfinite(v); ++k) v *= k;
+    }
+    for (b = 0; b < s; b += FACTORIAL_BLOCK) {
+        l = MIN(FACTORIAL_BLOCK, m - b);
+        if (n <= FACTORIAL_PASSES_ORDER) {
+            /* (m + 16)**16 < 2**1024, no overflow */
+            for (j = 0; j < FACTORIAL_BLOCK; ++j) f[j] = t[j] = (double)b + j + 1;
+            for (i = 0; i < l; i += FACTORIAL_LANES) {
+                for (k = 1; k < n; ++k) {
+                    for (j = i; j < i + FACTORIAL_LANES; ++j) f[j] *= t[j] + k;
+                }
+            }
+        } else {
+            for (j = 0; j < l && isfinite(v); ++j) {
+                f[j] = v;
+                v = v * ((double)(b + j) + n + 1) / (b + j + 1);
+            }
+            if (j < l) {
+                s = b + (l = j);
+            }
+        }
+        if (inverse) {
+            for (j = 0; j < l; ++j) f[j] = 1. / f[j];
+        }
+        kernels->scale_real(r + b, f, l);
+    }
+    for (j = s; j < m; ++j) {
+        if (inverse) {
+            r[j] = CZero;
+        } else {
+            r[j].real = (r[j].real == 0.) ? 0. : r[j].real * HUGE_VAL;
+            r[j].imag = (r[j].imag == 0.) ? 0. : r[j].imag * HUGE_VAL;
+        }
+    }
+}
+
+int
+poly_derive(Polynomial *A, unsigned int n, Polynomial *R)
+{
+    if (n == 0) {
+        return poly_copy(A, R);
+    }
+    if (!poly_init(R, (A->deg < 0 || n > (unsigned int)A->deg) ? -1 : A->deg - (int)n)) {
+        return 0;
+    }
+    if (R->deg == -1) {
+        return 1;
+    }
+    memcpy(R->coef, A->coef + n, (R->deg + 1) * sizeof(Complex));
+    _scale_factorial_ratios(R->coef, R->deg + 1, n, 0);
+    _poly_reset_bloom(R);
+    return 1;
+}
 
-    while (R->deg - B->deg >= 0) {
-        if (!poly_init(&T1, R->deg - B->deg)) goto error;
-        _poly_set_coef(&T1, R->deg - B->deg,
-                      complex_div(Poly_LeadCoef(R), B_leadcoef));
+int
+poly_integrate(Polynomial *A, unsigned int n, Polynomial *R)
+{
+    if (n == 0) {
+        return poly_copy(A, R);
+    }
+    if (A->deg != -1 && n > (unsigned int)(INT_MAX - 1 - A->deg)) {
+        return 0;
+    }
+    if (!poly_init(R, (A->deg == -1) ? -1 : A->deg + (int)n)) {
+        return 0;
+    }
+    if (R->deg == -1) {
+        return 1;
+    }
+    memcpy(R->coef + n, A->coef, (A->deg + 1) * sizeof(Complex));
+    _scale_factorial_ratios(R->coef + n, A->deg + 1, n, 1);
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
 
+/* Reduce R modulo B in place (B must not be zero).
+ * If Q is not NULL, the quotient is stored there: its storage must be
+ * able to hold deg R - deg B + 1 coefficients. */
+static void
+_poly_divmod_inplace(Polynomial *R, Polynomial *B, Polynomial *Q)
+{
+    Complex q, B_leadcoef = Poly_LeadCoef(B);
+    int k;
+    if (Q != NULL) {
+        Q->deg = MAX(-1, R->deg - B->deg);
+    }
+    for (k = R->deg - B->deg; k >= 0; --k) {
+        q = complex_div(R->coef[k + B->deg], B_leadcoef);
+        R->coef[k + B->deg] = CZero;
         if (Q != NULL) {
-            if (!poly_add(Q, &T1, &T2)) goto error;
-            poly_free(Q);
-            if (!poly_copy(&T2, Q)) goto error;
-            poly_free(&T2);
+            Q->coef[k] = q;
+        }
+        if (!complex_iszero(q)) {
+            kernels->axpy(R->coef + k, B->coef, complex_neg(q), B->deg);
         }
+    }
+    if (R->deg >= B->deg) {
+        R->deg = B->deg - 1;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    if (Q != NULL) {
+        Poly_ResizeDown(Q);
+        _poly_reset_bloom(Q);
+    }
+}
 
-        if (!poly_multiply(&T1, B, &T2)) goto error;
-        poly_free(&T1);
-        if (!poly_sub(R, &T2, &T1)) goto error;
-        poly_free(&T2);
+/* Euclidean division of A by B.
+ * If B is not zero, the resulting polynomials Q and R are defined by:
+ *      A = B * Q + R, deg R < deg B
+ * If B is zero, the operation is undefined and returns -1.
+ * Q may be NULL if only the remainder is needed.
+ */
+int
+poly_div(Polynomial *A, Polynomial *B, Polynomial *Q, Polynomial *R)
+{
+    if (!poly_init(R, (B->deg == -1) ? -1 : A->deg)) {
+        return 0;
+    }
+    if (B->deg == -1) {
+        return -1;  /* Division by zero */
+    }
+    if (Q != NULL && !poly_init(Q, MAX(-1, A->deg - B->deg))) {
         poly_free(R);
-        if(!poly_copy(&T1, R)) goto error;
-        poly_free(&T1);
+        return 0;
+    }
+    /* The remainder is computed in place, in a private copy of A */
+    if (A->deg >= 0) {
+        memcpy(R->coef, A->coef, (A->deg + 1) * sizeof(Complex));
     }
+    R->bloom = A->bloom;
+    _poly_divmod_inplace(R, B, Q);
     return 1;
-error:
-    if (Q != NULL) poly_free(Q);
-    poly_free(R);
-    poly_free(&T1);
-    poly_free(&T2);
-    return 0;
 }
 
 /* Greatest Common Divisor of A and B.
@@ -513,41 +2185,1696 @@ error:
  *   While B != 0
  *       A, B <= B, A % B   # Invariant: PGCD(A, B)
  *   P = A
+ *
+ * The remainders are computed in place, in two buffers drawn from an arena.
  */
 int
 poly_gcd(Polynomial *A, Polynomial *B, Polynomial *P)
 {
-    Polynomial R, T;
-    poly_init(P, -1);
-    poly_init(&R, -1);
-    poly_init(&T, -1);
+    PolyArena arena;
+    Polynomial U, V, T;
+    int ret;
+    if (A->deg < B->deg) {
+        Polynomial *C = A;
+        A = B;
+        B = C;
+    }
+    poly_arena_init(&arena, A->deg + B->deg + 2);
+    if (!poly_arena_poly(&arena, &U, A->deg) || !poly_arena_poly(&arena, &V, B->deg)) {
+        poly_arena_release(&arena);
+        return 0;
+    }
+    _poly_assign(A, &U);
+    _poly_assign(B, &V);
+    while (V.deg != -1) {
+        _poly_divmod_inplace(&U, &V, NULL);
+        T = U; U = V; V = T;
+    }
 
-    if (A->deg >= B->deg) {
-        if (!poly_copy(A, P)) goto error;
-        if (!poly_copy(B, &R)) goto error;
+    /* Result normalization */
+    if (U.deg == -1) {
+        ret = poly_init(P, -1);
     } else {
-        if (!poly_copy(B, P)) goto error;
-        if (!poly_copy(A, &R)) goto error;
-    }
-    while (R.deg != -1) {
-        if (!poly_copy(P, &T)) goto error;
-        poly_free(P);
-        if (!poly_copy(&R, P)) goto error;
-        poly_free(&R);
-        if (!poly_div(&T, P, NULL, &R)) goto error;
-        poly_free(&T);
+        ret = poly_scal_multiply(&U, complex_div(COne, Poly_LeadCoef(&U)), P);
+    }
+    poly_arena_release(&arena);
+    return ret;
+}
+
+/* Composition P(Q), with the powers Q**(2**k) in qpow[k].
+ * Divide and conquer: P = P0 + X**h P1 with h a power of two, so that
+ * P(Q) = P0(Q) + Q**h P1(Q), which takes O(M(deg P deg Q) log deg P) with
+ * fast products (Horner needs deg P products).
+ * r receives the (len - 1) m + 1 coefficients of P(Q), P of length len and Q
+ * of degree m. */
+static int
+_compose_rec(Complex *r, const Complex *p, int len, Complex **qpow, int m,
+             PolyArena *arena)
+{
+    int h = 1, k = 0, nlo, nhi, ret;
+    PolyArenaMark mark;
+    Complex *lo, *hi;
+    if (len == 1) {
+        r[0] = p[0];
+        return 1;
+    }
+    if (len == 2) {
+        kernels->scale(r, qpow[0], p[1], m + 1);
+        r[0] = complex_add(r[0], p[0]);
+        return 1;
     }
+    while (2 * h < len) {   /* Q**h = qpow[k] */
+        h *= 2;
+        ++k;
+    }
+    nlo = (h - 1) * m + 1;
+    nhi = (len - h - 1) * m + 1;
+    mark = poly_arena_mark(arena);
+    if ((lo = poly_arena_alloc(arena, nlo + nhi)) == NULL) {
+        return 0;
+    }
+    hi = lo + nlo;
+    ret = _compose_rec(lo, p, h, qpow, m, arena)
+            &&
+          _compose_rec(hi, p + h, len - h, qpow, m, arena)
+            &&
+          _mul_band(r, qpow[k], h * m + 1, hi, nhi, 0, (len - 1) * m + 1,
+                    POLY_MUL_AUTO, arena);
+    if (ret) {
+        kernels->add(r, r, lo, nlo);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+int
+poly_compose(Polynomial *P, Polynomial *Q, Polynomial *R)
+{
+    int m = Q->deg, n = P->deg, k, h, ret = 1;
+    Complex *qpow[32];
+    PolyArena arena;
+    if (n <= 0 || m <= 0) {
+        int failure = 0;
+        Complex c = (n == -1) ? CZero : poly_eval(P, Poly_GetCoef(Q, 0));
+        Poly_InitConst(R, c, failure)
+        return !failure;
+    }
+    if ((long long)n * m >= INT_MAX) {
+        return 0;
+    }
+    if (!poly_init(R, n * m)) {
+        return 0;
+    }
+    poly_arena_init(&arena, 4 * (n * m + 1) + MUL_SCRATCH_HINT(n * m, n * m));
+    qpow[0] = Q->coef;
+    for (k = 1, h = 2; ret && h < n + 1; ++k, h *= 2) {
+        ret = (qpow[k] = poly_arena_alloc(&arena, h * m + 1)) != NULL
+                &&
+              _mul_band(qpow[k], qpow[k - 1], h / 2 * m + 1,
+                        qpow[k - 1], h / 2 * m + 1, 0, h * m + 1,
+                        POLY_MUL_AUTO, &arena);
+    }
+    ret = ret && _compose_rec(R->coef, P->coef, n + 1, qpow, m, &arena);
+    poly_arena_release(&arena);
+    if (!ret) {
+        poly_free(R);
+        return 0;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
 
-    // Result normalization - could be faster.
-    Complex factor = complex_div((Complex){1, 0}, Poly_LeadCoef(P));
-    if (!poly_copy(P, &T)) goto error;
-    poly_free(P);
-    if (!poly_scal_multiply(&T, factor, P)) goto error;
-    poly_free(&T);
+/* r = a * b mod M, for a and b of length deg M, padded with zeros.
+ * T must be able to hold 2 deg M - 1 coefficients. */
+static int
+_compose_mulmod(Complex *r, const Complex *a, const Complex *b,
+                Polynomial *M, Polynomial *T, PolyArena *arena)
+{
+    int dm = M->deg;
+    T->deg = 2 * dm - 2;
+    if (!_mul_band(T->coef, a, dm, b, dm, 0, 2 * dm - 1, POLY_MUL_AUTO, arena)) {
+        return 0;
+    }
+    Poly_ResizeDown(T);
+    _poly_divmod_inplace(T, M, NULL);
+    memset(r, 0, dm * sizeof(Complex));
+    if (T->deg >= 0) {
+        memcpy(r, T->coef, (T->deg + 1) * sizeof(Complex));
+    }
     return 1;
-error:
-    poly_free(P);
-    poly_free(&T);
-    poly_free(&R);
-    return 0;
+}
+
+/* Modular composition P(Q) mod M (Brent and Kung).
+ * With s ~ sqrt(deg P), P is split into blocks of s coefficients:
+ *      P(Q) = sum(P_j(Q) Q**(s j))
+ * The blocks are evaluated with the baby steps Q**i mod M, i < s, which is
+ * a matrix product, and combined by Horner's rule on the giant step
+ * Q**s mod M: that is only O(sqrt(deg P)) products modulo M.
+ * Returns -1 if M is zero. */
+int
+poly_compose_mod(Polynomial *P, Polynomial *Q, Polynomial *M, Polynomial *R)
+{
+    int dm = M->deg, n = P->deg, s, t, i, j, ret = 1;
+    PolyArena arena;
+    Polynomial T;
+    Complex *baby, *acc, *block;
+    if (dm == -1) {
+        return -1;
+    }
+    if (dm == 0 || n == -1) {
+        poly_init(R, -1);
+        return 1;
+    }
+    s = (int)ceil(sqrt(n + 1.));
+    t = (n + s) / s;    /* Number of blocks */
+    poly_arena_init(&arena, (s + 3) * dm + MAX(Q->deg + 1, 2 * dm - 1)
+                            + MUL_SCRATCH_HINT(dm, dm));
+    if ((baby = poly_arena_alloc(&arena, (s + 3) * dm)) == NULL
+            ||
+        !poly_arena_poly(&arena, &T, MAX(Q->deg, 2 * dm - 2))) {
+        poly_arena_release(&arena);
+        return 0;
+    }
+    acc = baby + (s + 1) * dm;
+    block = acc + dm;
+    /* Baby steps, baby + i dm = Q**i mod M for i <= s */
+    memset(baby, 0, 2 * dm * sizeof(Complex));
+    baby[0] = COne;
+    _poly_assign(Q, &T);
+    _poly_divmod_inplace(&T, M, NULL);
+    if (T.deg >= 0) {
+        memcpy(baby + dm, T.coef, (T.deg + 1) * sizeof(Complex));
+    }
+    for (i = 2; ret && i <= s; ++i) {
+        ret = _compose_mulmod(baby + i * dm, baby + (i - 1) * dm, baby + dm,
+                              M, &T, &arena);
+    }
+    /* Horner's rule on the giant step, one block of P at a time */
+    memset(acc, 0, dm * sizeof(Complex));
+    for (j = t - 1; ret && j >= 0; --j) {
+        memset(block, 0, dm * sizeof(Complex));
+        for (i = 0; i < s && j * s + i <= n; ++i) {
+            if (!complex_iszero(P->coef[j * s + i])) {
+                kernels->axpy(block, baby + i * dm, P->coef[j * s + i], dm);
+            }
+        }
+        if (j < t - 1) {
+            ret = _compose_mulmod(acc, acc, baby + s * dm, M, &T, &arena);
+        }
+        kernels->add(acc, acc, block, dm);
+    }
+    if (ret && (ret = poly_init(R, dm - 1))) {
+        memcpy(R->coef, acc, dm * sizeof(Complex));
+        Poly_ResizeDown(R);
+        _poly_reset_bloom(R);
+    }
+    poly_arena_release(&arena);
+    return ret;
+}
+
+/* Taylor shift P(X + a): synthetic division below SHIFT_THRESHOLD
+ * coefficients, divide and conquer composition with the powers
+ * (X + a)**(2**k) beyond, O(M(n) log n).
+ * The O(M(n)) convolution with factorials (u[i] = i! p[i] against
+ * v[j] = a**j / j!) is not used: in floating point the dynamic range of the
+ * factorials leaves the fast products no significant digit on the low
+ * coefficients. */
+#define SHIFT_THRESHOLD         48
+
+/* r[0..n] holds P on input and P(X + a) on output.
+ * n steps of Horner's rule on the coefficients, O(n**2). */
+static void
+_shift_synthetic(Complex *r, int n, Complex a)
+{
+    int i, j;
+    for (i = 0; i < n; ++i) {
+        for (j = n - 1; j >= i; --j) {
+            r[j] = complex_add(r[j], complex_mult(a, r[j + 1]));
+        }
+    }
+}
+
+int
+poly_shift(Polynomial *P, Complex a, Polynomial *R)
+{
+    int n = P->deg, k, h, ret = 1;
+    Complex *qpow[32], base[2];
+    PolyArena arena;
+    if (n <= 0 || complex_iszero(a)) {
+        return poly_copy(P, R);
+    }
+    if (!poly_init(R, n)) {
+        return 0;
+    }
+    if (n + 1 < SHIFT_THRESHOLD) {
+        memcpy(R->coef, P->coef, (n + 1) * sizeof(Complex));
+        _shift_synthetic(R->coef, n, a);
+    } else {
+        poly_arena_init(&arena, 4 * (n + 1) + MUL_SCRATCH_HINT(n, n));
+        base[0] = a;
+        base[1] = COne;
+        qpow[0] = base;
+        for (k = 1, h = 2; ret && h < n + 1; ++k, h *= 2) {
+            ret = (qpow[k] = poly_arena_alloc(&arena, h + 1)) != NULL
+                    &&
+                  _mul_band(qpow[k], qpow[k - 1], h / 2 + 1,
+                            qpow[k - 1], h / 2 + 1, 0, h + 1,
+                            POLY_MUL_AUTO, &arena);
+        }
+        ret = ret && _compose_rec(R->coef, P->coef, n + 1, qpow, 1, &arena);
+        poly_arena_release(&arena);
+        if (!ret) {
+            poly_free(R);
+            return 0;
+        }
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+/* P(a X), coefficient i multiplied by a**i in a single pass.
+ * The support, hence the bloom filter, is unchanged unless a is zero
+ * (or the powers of a underflow, which only makes the filter looser). */
+int
+poly_scale(Polynomial *P, Complex a, Polynomial *R)
+{
+    int i, n = P->deg;
+    Complex ai = a;
+    if (complex_iszero(a)) {
+        int failure = 0;
+        Poly_InitConst(R, Poly_GetCoef(P, 0), failure)
+        return !failure;
+    }
+    if (!poly_init(R, n)) {
+        return 0;
+    }
+    if (n >= 0) {
+        R->coef[0] = P->coef[0];
+    }
+    for (i = 1; i <= n; ++i) {
+        R->coef[i] = complex_mult(P->coef[i], ai);
+        ai = complex_mult(ai, a);
+    }
+    R->bloom = P->bloom;
+    Poly_ResizeDown(R);
+    return 1;
+}
+
+/* Matrix evaluation, with n x n complex matrices stored row major.
+ * The product is tiled so that a MATRIX_BLOCK x MATRIX_BLOCK tile of each
+ * operand (16 KiB of complex each at 32) stays in the L1 / L2 cache, the
+ * innermost loop being an axpy along rows of b and c. */
+#define MATRIX_BLOCK            32
+
+/* c = a b, c must not overlap a or b */
+static void
+_matrix_multiply(Complex *POLY_RESTRICT c, const Complex *a,
+                 const Complex *b, int n)
+{
+    int ii, kk, jj, i, k, ni, nk, nj;
+    memset(c, 0, (size_t)n * n * sizeof(Complex));
+    for (ii = 0; ii < n; ii += MATRIX_BLOCK) {
+        ni = MIN(n, ii + MATRIX_BLOCK);
+        for (kk = 0; kk < n; kk += MATRIX_BLOCK) {
+            nk = MIN(n, kk + MATRIX_BLOCK);
+            for (jj = 0; jj < n; jj += MATRIX_BLOCK) {
+                nj = MIN(n - jj, MATRIX_BLOCK);
+                for (i = ii; i < ni; ++i) {
+                    for (k = kk; k < nk; ++k) {
+                        if (!complex_iszero(a[i * n + k])) {
+                            kernels->axpy(c + i * n + jj, b + k * n + jj,
+                                          a[i * n + k], nj);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* c += p I */
+static inline void
+_matrix_add_identity(Complex *c, Complex p, int n)
+{
+    int i;
+    for (i = 0; i < n; ++i) {
+        c[i * n + i] = complex_add(c[i * n + i], p);
+    }
+}
+
+/* P(A) with Paterson and Stockmeyer's method: with s ~ sqrt(deg P) and the
+ * powers A**i, i <= s, P is split into blocks of s coefficients
+ *      P(A) = sum(P_j(A) (A**s)**j)
+ * The blocks only take scalar multiplications and additions, and are
+ * combined by Horner's rule on A**s: 2 sqrt(deg P) matrix products instead
+ * of deg P.
+ * R receives the n x n result, and may not overlap A. */
+int
+poly_eval_matrix(Polynomial *P, const Complex *A, int n, Complex *R)
+{
+    int deg = P->deg, s, t, i, j, nn = n * n;
+    PolyArena arena;
+    Complex **pow, *block, *tmp, c;
+    if (n == 0) {
+        return 1;
+    }
+    memset(R, 0, (size_t)nn * sizeof(Complex));
+    if (deg <= 0) {
+        _matrix_add_identity(R, Poly_GetCoef(P, 0), n);
+        return 1;
+    }
+    s = (int)ceil(sqrt(deg + 1.));
+    t = (deg + s) / s;  /* Number of blocks */
+    /* Powers A**1 to A**s (A**0 is only added on the diagonal), a block and
+     * a temporary for the products */
+    if ((long long)nn * (s + 1) + s + 1 >= INT_MAX) {
+        return 0;
+    }
+    poly_arena_init(&arena, nn * (s + 1) + s + 1);
+    if ((pow = (Complex**)(void*)poly_arena_alloc(&arena, s + 1)) == NULL
+            ||
+        (block = poly_arena_alloc(&arena, nn * (s + 1))) == NULL) {
+        poly_arena_release(&arena);
+        return 0;
+    }
+    tmp = block + nn;
+    pow[0] = NULL;
+    pow[1] = (Complex*)A;
+    for (i = 2; i <= (t > 1 ? s : deg); ++i) {
+        pow[i] = tmp + (i - 1) * nn;
+        _matrix_multiply(pow[i], pow[i - 1], A, n);
+    }
+    for (j = t - 1; j >= 0; --j) {
+        /* block = P_j(A) */
+        memset(block, 0, (size_t)nn * sizeof(Complex));
+        for (i = 1; i < s && j * s + i <= deg; ++i) {
+            c = P->coef[j * s + i];
+            if (!complex_iszero(c)) {
+                kernels->axpy(block, pow[i], c, nn);
+            }
+        }
+        _matrix_add_identity(block, P->coef[j * s], n);
+        /* R = R A**s + block */
+        if (j < t - 1) {
+            _matrix_multiply(tmp, R, pow[s], n);
+            kernels->add(R, tmp, block, nn);
+        } else {
+            memcpy(R, block, (size_t)nn * sizeof(Complex));
+        }
+    }
+    poly_arena_release(&arena);
+    return 1;
+}
+
+/**
+ * In-place operators
+ * The destination is the first parameter, whose coefficients storage
+ * is reused and only grown when the result degree requires it.
+ * Parameters may alias each other (e.g. P += P).
+ */
+
+int
+poly_iadd(Polynomial *A, Polynomial *B)
+{
+    if (!poly_make_writable(A)) {
+        return 0;
+    }
+    if (B->deg > A->deg && !poly_realloc(A, B->deg)) {
+        return 0;
+    }
+    kernels->add(A->coef, A->coef, B->coef, B->deg + 1);
+    A->bloom |= B->bloom;
+    Poly_ResizeDown(A);
+    return 1;
+}
+
+int
+poly_isub(Polynomial *A, Polynomial *B)
+{
+    if (!poly_make_writable(A)) {
+        return 0;
+    }
+    if (B->deg > A->deg && !poly_realloc(A, B->deg)) {
+        return 0;
+    }
+    kernels->sub(A->coef, A->coef, B->coef, B->deg + 1);
+    A->bloom |= B->bloom;
+    Poly_ResizeDown(A);
+    return 1;
+}
+
+/* The product is computed from the highest coefficient down: the i-th
+ * coefficient only depends on coefficients of index <= i of both operands,
+ * which have not been overwritten yet. */
+int
+poly_imultiply(Polynomial *A, Polynomial *B)
+{
+    int i, j, A_deg, B_deg;
+    uint32_t A_bloom, B_bloom;
+    Complex s;
+    if (A->deg == -1) {
+        return 1;
+    }
+    if (B->deg == -1) {
+        A->deg = -1;
+        A->bloom = 0;
+        return 1;
+    }
+    if (!poly_make_writable(A)) {
+        return 0;
+    }
+    A_deg = A->deg;
+    B_deg = B->deg;
+    A_bloom = A->bloom;
+    B_bloom = B->bloom;
+    if (_poly_is_monomial(B) || _poly_is_monomial(A)) {
+        /* A single move and scaling: c X**k P, P being A or B */
+        Polynomial *P = A;
+        int k = B_deg;
+        Complex c = B->coef[B_deg];
+        if (!_poly_is_monomial(B)) {
+            P = B;
+            k = A_deg;
+            c = A->coef[A_deg];
+        }
+        if (!poly_realloc(A, A_deg + B_deg)) {
+            return 0;
+        }
+        A->bloom = Poly_BloomShift(P->bloom, k);
+        if (P == A) {
+            memmove(A->coef + k, A->coef, (A_deg + 1) * sizeof(Complex));
+            memset(A->coef, 0, k * sizeof(Complex));
+            if (c.real != 1. || c.imag != 0.) {
+                kernels->scale(A->coef + k, A->coef + k, c, A_deg + 1);
+            }
+        } else {
+            _mul_band_monomial(A->coef, B->coef, B_deg + 1, c, k, 0, A->deg + 1);
+        }
+        Poly_ResizeDown(A);
+        return 1;
+    }
+    if (MIN(A_deg, B_deg) + 1 >= KARATSUBA_THRESHOLD) {
+        /* Faster algorithms need a separate destination anyway */
+        Polynomial T;
+        if (!poly_multiply(A, B, &T)) {
+            return 0;
+        }
+        if (!poly_realloc(A, T.deg)) {
+            poly_free(&T);
+            return 0;
+        }
+        _poly_assign(&T, A);
+        poly_free(&T);
+        return 1;
+    }
+    if (!poly_realloc(A, A_deg + B_deg)) {
+        return 0;
+    }
+    for (i = A_deg + B_deg; i >= 0; --i) {
+        s = CZero;
+        for (j = MAX(0, i - B_deg); j <= i && j <= A_deg; ++j) {
+            if ((A_bloom & Poly_BloomMask(j)) && (B_bloom & Poly_BloomMask(i - j))) {
+                s = complex_add(s, complex_mult(A->coef[j], B->coef[i - j]));
+            }
+        }
+        A->coef[i] = s;
+    }
+    Poly_ResizeDown(A);
+    _poly_reset_bloom(A);
+    return 1;
+}
+
+/* The product is accumulated directly into the coefficients of A, as in
+ * poly_sum_of_products, unless an operand shares them (e.g. P += P * Q). */
+int
+poly_iaddmul(Polynomial *A, Polynomial *B, Polynomial *C)
+{
+    PolyArena arena;
+    long long deg;
+    int ret;
+    if (B->deg == -1 || C->deg == -1) {
+        return 1;
+    }
+    if (A->deg != -1 && (A->coef == B->coef || A->coef == C->coef)) {
+        Polynomial T;
+        if (!poly_multiply(B, C, &T)) {
+            return 0;
+        }
+        ret = poly_iadd(A, &T);
+        poly_free(&T);
+        return ret;
+    }
+    deg = (long long)B->deg + C->deg;
+    if (deg >= INT_MAX
+            ||
+        !poly_make_writable(A)
+            ||
+        (deg > A->deg && !poly_realloc(A, (int)deg))) {
+        return 0;
+    }
+    if (_poly_is_monomial(B)) {
+        Polynomial *T = B; B = C; C = T;
+    }
+    if (_poly_is_monomial(C)) {
+        kernels->axpy(A->coef + C->deg, B->coef, C->coef[C->deg], B->deg + 1);
+        A->bloom |= Poly_BloomShift(B->bloom, C->deg);
+    } else {
+        poly_arena_init(&arena, MUL_SCRATCH_HINT(B->deg + 1, C->deg + 1));
+        ret = _mul_accumulate(A->coef, B->coef, B->deg + 1, C->coef, C->deg + 1,
+                              COne, &arena);
+        poly_arena_release(&arena);
+        if (!ret) {
+            return 0;
+        }
+        if (!(A->flags & POLY_PINNED)) {
+            _poly_reset_bloom(A);
+        }
+    }
+    if (!(A->flags & POLY_PINNED)) {    /* see poly_pin */
+        Poly_ResizeDown(A);
+    }
+    return 1;
+}
+
+int
+poly_iderive(Polynomial *A, unsigned int n)
+{
+    if (n == 0) {
+        return 1;
+    }
+    if (A->deg < 0 || n > (unsigned int)A->deg) {
+        A->deg = -1;
+        A->bloom = 0;
+        return 1;
+    }
+    if (!poly_make_writable(A)) {
+        return 0;
+    }
+    memmove(A->coef, A->coef + n, (A->deg + 1 - n) * sizeof(Complex));
+    A->deg -= n;
+    _scale_factorial_ratios(A->coef, A->deg + 1, n, 0);
+    _poly_reset_bloom(A);
+    return 1;
+}
+
+int
+poly_iintegrate(Polynomial *A, unsigned int n)
+{
+    int deg;
+    if (n == 0 || A->deg == -1) {
+        return 1;
+    }
+    deg = A->deg;
+    if (n > (unsigned int)(INT_MAX - 1 - deg) || !poly_realloc(A, deg + (int)n)) {
+        return 0;
+    }
+    memmove(A->coef + n, A->coef, (deg + 1) * sizeof(Complex));
+    memset(A->coef, 0, n * sizeof(Complex));
+    _scale_factorial_ratios(A->coef + n, deg + 1, n, 1);
+    Poly_ResizeDown(A);
+    _poly_reset_bloom(A);
+    return 1;
+}
+
+/**
+ * Power series
+ * The operand is an exact Polynomial and the result is computed modulo X**n.
+ * Newton iterations double the precision at each step, using truncated and
+ * middle products, so that all the functions run in O(M(n)) where M(n) is the
+ * cost of a product.
+ * They return 0 on memory allocation failure, and -1 when the result is not
+ * a power series (e.g. inverse of a series with a zero constant term).
+ */
+
+/* r[0 .. n - 1] = 1 / a mod X**n, for a of length na with a[0] != 0 */
+static int
+_series_inverse(Complex *r, const Complex *a, int na, int n, PolyArena *arena)
+{
+    int i, k, m, ret = 1;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *e;
+    r[0] = complex_div(COne, a[0]);
+    for (k = 1; ret && k < n; k = m) {
+        m = MIN(2 * k, n);
+        /* a r = 1 + X**k e mod X**m, then r (1 - X**k e) = 1 / a mod X**m */
+        ret = (e = poly_arena_alloc(arena, m - k)) != NULL
+                &&
+              _mul_band(e, a, MIN(na, m), r, k, k, m, POLY_MUL_AUTO, arena)
+                &&
+              _mul_band(r + k, r, k, e, m - k, 0, m - k, POLY_MUL_AUTO, arena);
+        for (i = k; ret && i < m; ++i) {
+            r[i] = complex_neg(r[i]);
+        }
+        poly_arena_rewind(arena, mark);
+    }
+    return ret;
+}
+
+/* r[0 .. n - 1] = log(a) mod X**n, for a of length na with a[0] != 0:
+ * the integral of a' / a */
+static int
+_series_log(Complex *r, const Complex *a, int na, int n, PolyArena *arena)
+{
+    int i, nd = MIN(na, n) - 1, ret = 1;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *d, *q;
+    r[0] = complex_log(a[0]);
+    memset(r + 1, 0, (n - 1) * sizeof(Complex));
+    if (nd <= 0) {
+        return 1;
+    }
+    if ((d = poly_arena_alloc(arena, nd + 2 * (n - 1))) == NULL) {
+        return 0;
+    }
+    q = d + nd;
+    for (i = 0; i < nd; ++i) {
+        d[i].real = a[i + 1].real * (i + 1);
+        d[i].imag = a[i + 1].imag * (i + 1);
+    }
+    ret = _series_inverse(q + n - 1, a, na, n - 1, arena)
+            &&
+          _mul_band(q, d, nd, q + n - 1, n - 1, 0, n - 1, POLY_MUL_AUTO, arena);
+    for (i = 1; ret && i < n; ++i) {
+        r[i].real = q[i - 1].real / i;
+        r[i].imag = q[i - 1].imag / i;
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0 .. n - 1] = exp(a) mod X**n, for a of length na */
+static int
+_series_exp(Complex *r, const Complex *a, int na, int n, PolyArena *arena)
+{
+    int i, k, m, ret = 1;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *l, e0 = complex_exp(a[0]);
+    if ((l = poly_arena_alloc(arena, n)) == NULL) {
+        return 0;
+    }
+    r[0] = COne;
+    for (k = 1; ret && k < n; k = m) {
+        m = MIN(2 * k, n);
+        /* log(r) = a - a[0] mod X**k, then r (1 + a - log(r)) doubles the
+         * precision, where a - log(r) is a multiple of X**k */
+        if ((ret = _series_log(l, r, k, m, arena))) {
+            for (i = k; i < m; ++i) {
+                l[i] = complex_sub(i < na ? a[i] : CZero, l[i]);
+            }
+            ret = _mul_band(r + k, r, k, l + k, m - k, 0, m - k,
+                            POLY_MUL_AUTO, arena);
+        }
+    }
+    for (i = 0; ret && i < n; ++i) {
+        r[i] = complex_mult(r[i], e0);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0 .. n - 1] = sqrt(a) mod X**n, for a of length na with a[0] != 0 */
+static int
+_series_sqrt(Complex *r, const Complex *a, int na, int n, PolyArena *arena)
+{
+    int i, k, m, ret = 1;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *inv;
+    if ((inv = poly_arena_alloc(arena, n)) == NULL) {
+        return 0;
+    }
+    r[0] = complex_sqrt(a[0]);
+    for (k = 1; ret && k < n; k = m) {
+        m = MIN(2 * k, n);
+        /* r + (a / r - r) / 2, where a / r - r is a multiple of X**k */
+        ret = _series_inverse(inv, r, k, m, arena)
+                &&
+              _mul_band(r + k, a, MIN(na, m), inv, m, k, m, POLY_MUL_AUTO, arena);
+        for (i = k; ret && i < m; ++i) {
+            r[i].real /= 2;
+            r[i].imag /= 2;
+        }
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0 .. n - 1] = a**e mod X**n, for a of length na with a[0] != 0 */
+static int
+_series_pow(Complex *r, const Complex *a, int na, int n, Complex e,
+            PolyArena *arena)
+{
+    int i, ret;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *l;
+    if ((l = poly_arena_alloc(arena, n)) == NULL) {
+        return 0;
+    }
+    if ((ret = _series_log(l, a, na, n, arena))) {
+        for (i = 0; i < n; ++i) {
+            l[i] = complex_mult(l[i], e);
+        }
+        ret = _series_exp(r, l, n, n, arena);
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* P = P mod X**n, in place */
+void
+poly_truncate(Polynomial *P, int n)
+{
+    if (P->deg >= n) {
+        P->deg = MAX(n, 0) - 1;
+        Poly_ResizeDown(P);
+    }
+}
+
+/* Index of the first non zero coefficient of P, -1 if P is zero */
+int
+poly_valuation(Polynomial *P)
+{
+    int i;
+    for (i = 0; i <= P->deg; ++i) {
+        if (!complex_iszero(Poly_GetCoef(P, i))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#define SERIES_INVERSE  0
+#define SERIES_LOG      1
+#define SERIES_EXP      2
+#define SERIES_SQRT     3
+#define SERIES_POW      4
+
+/* R = f(A) mod X**n.
+ * For pow, the valuation v of A is factored out beforehand:
+ * (X**v B)**e = X**(v e) B**e, provided v e is a non negative integer. */
+static int
+_poly_series(int f, Polynomial *A, Complex e, int n, Polynomial *R)
+{
+    int v = poly_valuation(A), shift = 0, ret = 1;
+    double s;
+    const Complex *a = A->coef;
+    int na = A->deg + 1;
+    PolyArena arena;
+    if (v == -1) {
+        if (f == SERIES_EXP || (f == SERIES_POW && complex_iszero(e))) {
+            f = SERIES_EXP;     /* exp(0) = 0**0 = 1 */
+            a = &CZero;
+            na = 1;
+        } else if (f == SERIES_SQRT || (f == SERIES_POW && e.imag == 0.
+                                        && e.real > 0.)) {
+            poly_init(R, -1);
+            return 1;
+        } else {
+            return -1;
+        }
+    } else if (v > 0 && f != SERIES_EXP) {
+        if (f == SERIES_SQRT) {
+            s = 0.5 * v;
+        } else if (f == SERIES_POW && e.imag == 0.) {
+            s = e.real * v;
+        } else {
+            return -1;
+        }
+        if (s != floor(s) || s < 0.) {
+            return -1;
+        }
+        shift = (s >= n) ? n : (int)s;
+        a += v;
+        na -= v;
+    }
+    if (n - shift <= 0) {
+        poly_init(R, -1);
+        return 1;
+    }
+    if (!poly_init(R, n - 1)) {
+        return 0;
+    }
+    n -= shift;
+    poly_arena_init(&arena, 8 * n + MUL_SCRATCH_HINT(n, n));
+    switch (f) {
+    case SERIES_INVERSE:
+        ret = _series_inverse(R->coef, a, na, n, &arena);
+        break;
+    case SERIES_LOG:
+        ret = _series_log(R->coef, a, na, n, &arena);
+        break;
+    case SERIES_EXP:
+        ret = _series_exp(R->coef, a, na, n, &arena);
+        break;
+    case SERIES_SQRT:
+        ret = _series_sqrt(R->coef + shift, a, na, n, &arena);
+        break;
+    default:
+        ret = _series_pow(R->coef + shift, a, na, n, e, &arena);
+    }
+    poly_arena_release(&arena);
+    if (!ret) {
+        poly_free(R);
+        return 0;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+int
+poly_series_inverse(Polynomial *A, int n, Polynomial *R)
+{
+    return _poly_series(SERIES_INVERSE, A, CZero, n, R);
+}
+
+int
+poly_series_log(Polynomial *A, int n, Polynomial *R)
+{
+    return _poly_series(SERIES_LOG, A, CZero, n, R);
+}
+
+int
+poly_series_exp(Polynomial *A, int n, Polynomial *R)
+{
+    return _poly_series(SERIES_EXP, A, CZero, n, R);
+}
+
+int
+poly_series_sqrt(Polynomial *A, int n, Polynomial *R)
+{
+    return _poly_series(SERIES_SQRT, A, CZero, n, R);
+}
+
+/* Non negative integer powers: binary exponentiation with truncated
+ * products, which is more accurate than going through exp and log. */
+static int
+_poly_series_ipow(Polynomial *A, unsigned int k, int n, Polynomial *R)
+{
+    Polynomial S, T;
+    int failure = 0;
+    if (n <= 0) {
+        poly_init(R, -1);
+        return 1;
+    }
+    Poly_InitConst(R, COne, failure)
+    if (failure) {
+        return 0;
+    }
+    if (!poly_copy(A, &S)) {
+        poly_free(R);
+        return 0;
+    }
+    poly_truncate(&S, n);
+    while (k != 0) {
+        if (k & 1) {
+            if (!poly_mul_low(R, &S, n, POLY_MUL_AUTO, &T)) {
+                failure = 1;
+                break;
+            }
+            poly_free(R);
+            *R = T;
+        }
+        if ((k >>= 1) != 0) {
+            if (!poly_mul_low(&S, &S, n, POLY_MUL_AUTO, &T)) {
+                failure = 1;
+                break;
+            }
+            poly_free(&S);
+            S = T;
+        }
+    }
+    poly_free(&S);
+    if (failure) {
+        poly_free(R);
+        return 0;
+    }
+    return 1;
+}
+
+int
+poly_series_pow(Polynomial *A, Complex e, int n, Polynomial *R)
+{
+    if (e.imag == 0. && e.real >= 0. && e.real <= UINT_MAX
+            && e.real == floor(e.real)) {
+        return _poly_series_ipow(A, (unsigned int)e.real, n, R);
+    }
+    return _poly_series(SERIES_POW, A, e, n, R);
+}
+
+/**
+ * Orthogonal polynomials
+ * The coefficients are filled from the leading one down through the ratio
+ * of consecutive nonzero coefficients, which are those of degree n - 2m:
+ *      c[n - 2m - 2] = c[n - 2m] * ratio(n, m)
+ * so each polynomial takes O(n) and no product.
+ */
+
+#define ORTHO_CHEBYSHEV     0
+#define ORTHO_LEGENDRE      1
+#define ORTHO_HERMITE       2
+
+/* r[0..n] = coefficients of the polynomial of degree n of the family */
+static void
+_orthogonal_fill(int kind, int n, Complex *r)
+{
+    int m, k;
+    double c, num;
+    switch (kind) {
+    case ORTHO_CHEBYSHEV:   /* 2**(n-1) */
+        c = (n == 0) ? 1. : ldexp(1., n - 1);
+        break;
+    case ORTHO_LEGENDRE:    /* (2n)! / (2**n n!**2) = (2n - 1)!! / n! */
+        for (c = 1., k = 1; k <= n; ++k) {
+            c *= (2. * k - 1.) / k;
+        }
+        break;
+    default:
+        c = 1.;
+    }
+    memset(r, 0, (n + 1) * sizeof(Complex));
+    for (m = 0; ; ++m) {
+        k = n - 2 * m;
+        r[k].real = c;
+        if (k < 2) {
+            break;
+        }
+        num = -(double)k * (k - 1);
+        switch (kind) {
+        case ORTHO_CHEBYSHEV:
+            c *= num / (4. * (m + 1) * (n - m - 1));
+            break;
+        case ORTHO_LEGENDRE:
+            c *= num / (2. * (m + 1) * (2 * n - 2 * m - 1));
+            break;
+        default:
+            c *= num / (2. * (m + 1));
+        }
+    }
+}
+
+static int
+_poly_orthogonal(int kind, int n, Polynomial *R)
+{
+    if (!poly_init(R, n)) {
+        return 0;
+    }
+    _orthogonal_fill(kind, n, R->coef);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+int
+poly_chebyshev(int n, Polynomial *R)
+{
+    return _poly_orthogonal(ORTHO_CHEBYSHEV, n, R);
+}
+
+int
+poly_legendre(int n, Polynomial *R)
+{
+    return _poly_orthogonal(ORTHO_LEGENDRE, n, R);
+}
+
+int
+poly_hermite(int n, Polynomial *R)
+{
+    return _poly_orthogonal(ORTHO_HERMITE, n, R);
+}
+
+/**
+ * Chebyshev series
+ * A Polynomial C whose coefficient i is that of T_i rather than X**i:
+ *      C = c[0] T_0 + c[1] T_1 + ... + c[deg] T_deg
+ * Sums, differences and scalar products are those of polynomials.
+ */
+
+#define CHEB_DCT_THRESHOLD      128 /* Direct products below this length */
+#define CHEB_CONVERT_THRESHOLD  32  /* Direct conversions below this length */
+
+char*
+poly_cheb_to_string(Polynomial *C)
+{
+    return _poly_to_string(C, "T1", "T%d");
+}
+
+/* Clenshaw's recurrence, the analogue of Horner's method, which is stable
+ * for |x| <= 1. */
+Complex
+poly_cheb_eval(Polynomial *C, Complex x)
+{
+    Complex b1 = CZero, b2 = CZero, t, x2 = complex_mult_real(x, 2.);
+    int k;
+    if (C->deg == -1) {
+        return CZero;
+    }
+    for (k = C->deg; k >= 1; --k) {
+        t = complex_add(complex_sub(complex_mult(x2, b1), b2), C->coef[k]);
+        b2 = b1;
+        b1 = t;
+    }
+    return complex_sub(complex_add(C->coef[0], complex_mult(x, b1)), b2);
+}
+
+void
+poly_cheb_eval_many(Polynomial *C, const Complex *x, Complex *y, int m)
+{
+    kernels->clenshaw(C->coef, C->deg, x, y, m);
+}
+
+/* r[0..na+nb-2] = a * b with T_i T_j = (T_{i+j} + T_{|i-j|}) / 2 */
+static void
+_cheb_mul_direct(Complex *r, const Complex *a, int na, const Complex *b, int nb)
+{
+    int i, j;
+    Complex h;
+    memset(r, 0, (na + nb - 1) * sizeof(Complex));
+    for (i = 0; i < na; ++i) {
+        if (complex_iszero(a[i])) {
+            continue;
+        }
+        h = complex_mult_real(a[i], 0.5);
+        kernels->axpy(r + i, b, h, nb);                         /* T_{i+j} */
+        if (nb > i) {
+            kernels->axpy(r, b + i, h, nb - i);                 /* T_{j-i}, j >= i */
+        }
+        for (j = 0; j < i && j < nb; ++j) {                     /* T_{i-j}, j < i */
+            r[i - j] = complex_add(r[i - j], complex_mult(h, b[j]));
+        }
+    }
+}
+
+/* DCT-I of x[0..N] through an FFT of length 2N of its even extension:
+ *      x[k] <- x[0] + (-1)**k x[N] + 2 sum(x[j] cos(pi j k / N), 0 < j < N)
+ * x has room for 2N coefficients, w holds the twiddles of order 2N. */
+static void
+_cheb_dct(Complex *x, int N, const Complex *w)
+{
+    int j;
+    for (j = 1; j < N; ++j) {
+        x[2 * N - j] = x[j];
+    }
+    _fft(x, 2 * N, w, 0);
+}
+
+/* Product by interpolation at the N + 1 extrema cos(pi k / N) of T_N, with
+ * N >= deg a + deg b a power of two: the values of a and b there are DCTs of
+ * their coefficients, multiplied pointwise, and the coefficients of the
+ * product are the DCT of the values (the DCT-I is its own inverse, up to the
+ * halving of the first and last terms and a factor 2 / N). */
+static int
+_cheb_mul_dct(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+              PolyArena *arena)
+{
+    int N = 1, i;
+    PolyArenaMark mark = poly_arena_mark(arena);
+    Complex *x, *y, *w, a0, aN, b0, bN;
+    while (N < na + nb - 2) {
+        N <<= 1;
+    }
+    if ((x = poly_arena_alloc(arena, 4 * N + N)) == NULL) {
+        return 0;
+    }
+    y = x + 2 * N;
+    w = y + 2 * N;
+    for (i = 0; i < N; ++i) {
+        w[i].real = cos(PI * i / N);
+        w[i].imag = -sin(PI * i / N);
+    }
+    memset(x, 0, (N + 1) * sizeof(Complex));
+    memset(y, 0, (N + 1) * sizeof(Complex));
+    memcpy(x, a, na * sizeof(Complex));
+    memcpy(y, b, nb * sizeof(Complex));
+    a0 = x[0], aN = x[N], b0 = y[0], bN = y[N];
+    _cheb_dct(x, N, w);
+    _cheb_dct(y, N, w);
+    /* Values: (DCT + x[0] + (-1)**k x[N]) / 2, and their product */
+    for (i = 0; i <= N; ++i) {
+        x[i] = complex_add(x[i], (i & 1) ? complex_sub(a0, aN) : complex_add(a0, aN));
+        y[i] = complex_add(y[i], (i & 1) ? complex_sub(b0, bN) : complex_add(b0, bN));
+        x[i] = complex_mult_real(complex_mult(x[i], y[i]), 0.25);
+    }
+    _cheb_dct(x, N, w);
+    for (i = 0; i < na + nb - 1; ++i) {
+        r[i] = complex_mult_real(x[i], (i == 0 || i == N) ? 0.5 / N : 1. / N);
+    }
+    poly_arena_rewind(arena, mark);
+    return 1;
+}
+
+/* r[0..na+nb-2] = a * b, r does not overlap a or b */
+static int
+_cheb_mul(Complex *r, const Complex *a, int na, const Complex *b, int nb,
+          PolyArena *arena)
+{
+    if (MIN(na, nb) < CHEB_DCT_THRESHOLD) {
+        _cheb_mul_direct(r, a, na, b, nb);
+        return 1;
+    }
+    return _cheb_mul_dct(r, a, na, b, nb, arena);
+}
+
+int
+poly_cheb_multiply(Polynomial *A, Polynomial *B, Polynomial *R)
+{
+    PolyArena arena;
+    int ret;
+    if (A->deg == -1 || B->deg == -1) {
+        poly_init(R, -1);
+        return 1;
+    }
+    if (!poly_init(R, A->deg + B->deg)) {
+        return 0;
+    }
+    poly_arena_init(&arena, 5 * (A->deg + B->deg + 2));
+    ret = _cheb_mul(R->coef, A->coef, A->deg + 1, B->coef, B->deg + 1, &arena);
+    poly_arena_release(&arena);
+    if (!ret) {
+        poly_free(R);
+        return 0;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+/* Conversions between the monomial and Chebyshev bases, by divide and
+ * conquer on a split at h, the largest power of two below the length:
+ * to Chebyshev,
+ *      P = P0 + X**h P1  =>  cheb(P) = cheb(P0) + cheb(X**h) cheb(P1)
+ * and from Chebyshev, with T_{h+j} = 2 T_h T_j - T_{h-j},
+ *      C = C0 + sum(c[h+j] T_{h+j})
+ *        = (C0 - sum(c[h+j] T_{h-j}, j > 0)) + T_h (c[h] + 2 sum(c[h+j] T_j, j > 0))
+ * with the powers X**(2**k) (resp. T_(2**k)) in the other basis precomputed.
+ * Both take O(M(n) log n). */
+
+/* r[0..len-1] = cheb(p), the powers cheb(X**(2**k)) in xpow[k] */
+static int
+_cheb_from_poly_rec(Complex *r, const Complex *p, int len, Complex **xpow,
+                    PolyArena *arena)
+{
+    int h = 1, k = 0, i, ret;
+    PolyArenaMark mark;
+    Complex *hi;
+    if (len < CHEB_CONVERT_THRESHOLD) {
+        /* Horner's rule, with X T_0 = T_1 and X T_i = (T_{i+1} + T_{i-1}) / 2 */
+        Complex prev, cur, next;
+        memset(r, 0, len * sizeof(Complex));
+        for (k = len - 1; k >= 0; --k) {
+            for (prev = CZero, i = 0; i < len - k; ++i) {
+                cur = r[i];
+                next = (i + 1 < len) ? r[i + 1] : CZero;
+                if (i == 0) {
+                    r[0] = complex_mult_real(next, 0.5);
+                } else if (i == 1) {
+                    r[1] = complex_add(prev, complex_mult_real(next, 0.5));
+                } else {
+                    r[i] = complex_mult_real(complex_add(prev, next), 0.5);
+                }
+                prev = cur;
+            }
+            r[0] = complex_add(r[0], p[k]);
+        }
+        return 1;
+    }
+    while (2 * h < len) {   /* cheb(X**h) = xpow[k] */
+        h *= 2;
+        ++k;
+    }
+    mark = poly_arena_mark(arena);
+    if ((hi = poly_arena_alloc(arena, len - h)) == NULL) {
+        return 0;
+    }
+    ret = _cheb_from_poly_rec(hi, p + h, len - h, xpow, arena);
+    if (ret) {
+        Complex *lo = poly_arena_alloc(arena, h);
+        ret = lo != NULL
+                &&
+              _cheb_from_poly_rec(lo, p, h, xpow, arena)
+                &&
+              _cheb_mul(r, xpow[k], h + 1, hi, len - h, arena);
+        if (ret) {
+            kernels->add(r, r, lo, h);
+        }
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* r[0..len-1] = monomial coefficients of c, T_(2**k) in tpow[k].
+ * r may be c. */
+static int
+_cheb_to_poly_rec(Complex *r, const Complex *c, int len, Complex **tpow,
+                  PolyArena *arena)
+{
+    int h = 1, k = 0, j, ret;
+    PolyArenaMark mark;
+    Complex *lo, *d;
+    if (len < CHEB_CONVERT_THRESHOLD) {
+        /* Clenshaw's recurrence on polynomials: b_k = c_k + 2 X b_{k+1} - b_{k+2} */
+        Complex *b1, *b2, *t;
+        mark = poly_arena_mark(arena);
+        if ((b1 = poly_arena_alloc(arena, 2 * len)) == NULL) {
+            return 0;
+        }
+        b2 = b1 + len;
+        memset(b1, 0, 2 * len * sizeof(Complex));
+        for (k = len - 1; k >= 1; --k) {
+            /* b2 <- c_k + 2 X b1 - b2, then swap */
+            for (j = len - 1; j >= 1; --j) {
+                b2[j] = complex_sub(complex_mult_real(b1[j - 1], 2.), b2[j]);
+            }
+            b2[0] = complex_sub(c[k], b2[0]);
+            t = b1; b1 = b2; b2 = t;
+        }
+        /* c_0 + X b_1 - b_2 */
+        r[0] = complex_sub(c[0], b2[0]);
+        for (j = 1; j < len; ++j) {
+            r[j] = complex_sub(b1[j - 1], b2[j]);
+        }
+        poly_arena_rewind(arena, mark);
+        return 1;
+    }
+    while (2 * h < len) {   /* T_h = tpow[k] */
+        h *= 2;
+        ++k;
+    }
+    mark = poly_arena_mark(arena);
+    if ((lo = poly_arena_alloc(arena, h + (len - h))) == NULL) {
+        return 0;
+    }
+    d = lo + h;
+    memcpy(lo, c, h * sizeof(Complex));
+    d[0] = c[h];
+    for (j = 1; j < len - h; ++j) {
+        lo[h - j] = complex_sub(lo[h - j], c[h + j]);
+        d[j] = complex_mult_real(c[h + j], 2.);
+    }
+    ret = _cheb_to_poly_rec(lo, lo, h, tpow, arena);
+    if (ret) {
+        Complex *hi = poly_arena_alloc(arena, len - h);
+        ret = hi != NULL
+                &&
+              _cheb_to_poly_rec(hi, d, len - h, tpow, arena)
+                &&
+              _mul_band(r, tpow[k], h + 1, hi, len - h, 0, len,
+                        POLY_MUL_AUTO, arena);
+        if (ret) {
+            kernels->add(r, r, lo, h);
+        }
+    }
+    poly_arena_rewind(arena, mark);
+    return ret;
+}
+
+/* Converts P to the Chebyshev basis if to_cheb, from it otherwise */
+static int
+_poly_cheb_convert(Polynomial *P, Polynomial *R, int to_cheb)
+{
+    int n = P->deg + 1, k, h, ret = 1;
+    Complex *pow[32];
+    PolyArena arena;
+    if (!poly_init(R, P->deg)) {
+        return 0;
+    }
+    if (n == 0) {
+        return 1;
+    }
+    poly_arena_init(&arena, 8 * n + MUL_SCRATCH_HINT(n, n));
+    for (k = 0, h = 1; ret && h < n; ++k, h *= 2) {
+        if ((pow[k] = poly_arena_alloc(&arena, h + 1)) == NULL) {
+            ret = 0;
+        } else if (!to_cheb) {
+            _orthogonal_fill(ORTHO_CHEBYSHEV, h, pow[k]);
+        } else if (k == 0) {
+            pow[0][0] = CZero;
+            pow[0][1] = COne;
+        } else {
+            ret = _cheb_mul(pow[k], pow[k - 1], h / 2 + 1, pow[k - 1], h / 2 + 1,
+                            &arena);
+        }
+    }
+    if (ret && to_cheb) {
+        ret = _cheb_from_poly_rec(R->coef, P->coef, n, pow, &arena);
+    } else if (ret) {
+        ret = _cheb_to_poly_rec(R->coef, P->coef, n, pow, &arena);
+    }
+    poly_arena_release(&arena);
+    if (!ret) {
+        poly_free(R);
+        return 0;
+    }
+    Poly_ResizeDown(R);
+    _poly_reset_bloom(R);
+    return 1;
+}
+
+int
+poly_cheb_from_poly(Polynomial *P, Polynomial *R)
+{
+    return _poly_cheb_convert(P, R, 1);
+}
+
+int
+poly_cheb_to_poly(Polynomial *C, Polynomial *R)
+{
+    return _poly_cheb_convert(C, R, 0);
+}
+
+/**
+ * Polynomial arrays
+ * The coefficients matrix is a single coefficients array, see PolyArray.
+ * Products go through the batch ARRAY_BLOCK polynomials at a time, so that
+ * the coefficients of a block stay in cache across the loops over the
+ * degrees, while each loop still runs over many lanes. Evaluations keep the
+ * values of HORNER_LANES polynomials in registers, see horner_lanes.
+ */
+
+#define ARRAY_BLOCK     256
+
+/* Allocate the coefficients of n polynomials of degree at most deg, without
+ * initializing them */
+static int
+_array_alloc(PolyArray *A, int n, int deg)
+{
+    long long size = (long long)n * (deg + 1);
+    if (size >= INT_MAX) {
+        return 0;
+    }
+    A->capacity = pool_capacity((int)size);
+    A->coef = NULL;
+    if (size > 0 && (A->coef = coef_alloc(A->capacity)) == NULL) {
+        return 0;
+    }
+    A->n = n;
+    A->deg = deg;
+    return 1;
+}
+
+/* Lower the degree bound of A below its columns of zeros */
+static void
+_array_resize_down(PolyArray *A)
+{
+    int i;
+    while (A->deg != -1) {
+        for (i = 0; i < A->n; ++i) {
+            if (!complex_iszero(A->coef[A->deg * A->n + i])) {
+                return;
+            }
+        }
+        --(A->deg);
+    }
+}
+
+/* Create an array of n zero polynomials, with room for degree "deg" */
+int
+poly_array_init(PolyArray *A, int n, int deg)
+{
+    if (!_array_alloc(A, n, deg)) {
+        return 0;
+    }
+    if (A->coef != NULL) {
+        memset(A->coef, 0, (size_t)n * (deg + 1) * sizeof(Complex));
+    }
+    return 1;
+}
+
+void
+poly_array_free(PolyArray *A)
+{
+    coef_free(A->coef, A->capacity);
+    A->coef = NULL;
+    A->capacity = 0;
+}
+
+/* Change the degree bound of A, the new coefficients being zero. Columns
+ * are contiguous, so growing only appends columns to the array. */
+int
+poly_array_realloc(PolyArray *A, int deg)
+{
+    long long size = (long long)A->n * (deg + 1);
+    int capacity;
+    Complex *coef;
+    if (size >= INT_MAX) {
+        return 0;
+    }
+    if (size > A->capacity) {
+        capacity = pool_capacity((int)size);
+        coef = coef_realloc(A->coef, A->capacity, A->n * (A->deg + 1), capacity);
+        if (coef == NULL) {
+            return 0;
+        }
+        A->coef = coef;
+        A->capacity = capacity;
+    }
+    if (deg > A->deg) {
+        memset(A->coef + A->n * (A->deg + 1), 0,
+               (size_t)A->n * (deg - A->deg) * sizeof(Complex));
+    }
+    A->deg = deg;
+    return 1;
+}
+
+/* Copy the polynomial i of A to P */
+int
+poly_array_get(PolyArray *A, int i, Polynomial *P)
+{
+    int j;
+    if (!poly_init(P, A->deg)) {
+        return 0;
+    }
+    for (j = 0; j <= A->deg; ++j) {
+        P->coef[j] = A->coef[j * A->n + i];
+    }
+    Poly_ResizeDown(P);
+    _poly_reset_bloom(P);
+    return 1;
+}
+
+/* Set the polynomial i of A to P, whose degree must fit in A */
+void
+poly_array_set(PolyArray *A, int i, Polynomial *P)
+{
+    int j;
+    for (j = 0; j <= A->deg; ++j) {
+        A->coef[j * A->n + i] = (j <= P->deg) ? P->coef[j] : CZero;
+    }
+}
+
+int
+poly_array_equal(PolyArray *A, PolyArray *B)
+{
+    int i, j, n = A->n;
+    PolyArray *L = (A->deg >= B->deg) ? A : B;
+    if (A->n != B->n) {
+        return 0;
+    }
+    for (j = 0; j <= L->deg; ++j) {
+        for (i = 0; i < n; ++i) {
+            if (j > A->deg || j > B->deg) {
+                if (!complex_iszero(L->coef[j * n + i])) {
+                    return 0;
+                }
+            } else if (A->coef[j * n + i].real != B->coef[j * n + i].real
+                       ||
+                       A->coef[j * n + i].imag != B->coef[j * n + i].imag) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* R = A + B or A - B: the common columns in a single kernel call, the
+ * others are copied */
+static int
+_array_add(PolyArray *A, PolyArray *B, PolyArray *R, int subtract)
+{
+    int n = A->n, lo = MIN(A->deg, B->deg), hi = MAX(A->deg, B->deg);
+    Complex minus_one = {-1., 0.};
+    if (!_array_alloc(R, n, hi)) {
+        return 0;
+    }
+    if (subtract) {
+        kernels->sub(R->coef, A->coef, B->coef, (lo + 1) * n);
+    } else {
+        kernels->add(R->coef, A->coef, B->coef, (lo + 1) * n);
+    }
+    if (A->deg > lo) {
+        memcpy(R->coef + (lo + 1) * n, A->coef + (lo + 1) * n,
+               (size_t)(hi - lo) * n * sizeof(Complex));
+    } else if (B->deg > lo && subtract) {
+        kernels->scale(R->coef + (lo + 1) * n, B->coef + (lo + 1) * n,
+                       minus_one, (hi - lo) * n);
+    } else if (B->deg > lo) {
+        memcpy(R->coef + (lo + 1) * n, B->coef + (lo + 1) * n,
+               (size_t)(hi - lo) * n * sizeof(Complex));
+    }
+    _array_resize_down(R);
+    return 1;
+}
+
+int
+poly_array_add(PolyArray *A, PolyArray *B, PolyArray *R)
+{
+    return _array_add(A, B, R, 0);
+}
+
+int
+poly_array_sub(PolyArray *A, PolyArray *B, PolyArray *R)
+{
+    return _array_add(A, B, R, 1);
+}
+
+int
+poly_array_scale(PolyArray *A, Complex c, PolyArray *R)
+{
+    if (!_array_alloc(R, A->n, A->deg)) {
+        return 0;
+    }
+    kernels->scale(R->coef, A->coef, c, (A->deg + 1) * A->n);
+    _array_resize_down(R);
+    return 1;
+}
+
+/* Schoolbook products, each coefficient pair (j, k) being one elementwise
+ * multiply-add over the lanes of a block */
+int
+poly_array_multiply(PolyArray *A, PolyArray *B, PolyArray *R)
+{
+    int n = A->n, p, m, j, k;
+    int deg = (A->deg == -1 || B->deg == -1) ? -1 : A->deg + B->deg;
+    if (!poly_array_init(R, n, deg)) {
+        return 0;
+    }
+    for (p = 0; p < n && deg != -1; p += ARRAY_BLOCK) {
+        m = MIN(ARRAY_BLOCK, n - p);
+        for (j = 0; j <= A->deg; ++j) {
+            for (k = 0; k <= B->deg; ++k) {
+                kernels->hadamard_acc(R->coef + (j + k) * n + p,
+                                      A->coef + j * n + p,
+                                      B->coef + k * n + p, m);
+            }
+        }
+    }
+    _array_resize_down(R);
+    return 1;
+}
+
+/* Euclidean divisions of the polynomials of A by those of B, which are
+ * gathered one at a time into contiguous buffers: the divisors may have
+ * different degrees, hence different leading coefficients positions.
+ * Returns -1 if a polynomial of B is zero. */
+int
+poly_array_div(PolyArray *A, PolyArray *B, PolyArray *Q, PolyArray *R)
+{
+    int n = A->n, i, j, db, db_min = INT_MAX, db_max = -1;
+    Polynomial a, b, q;
+    PolyArena arena;
+    for (i = 0; i < n; ++i) {
+        for (db = B->deg; db >= 0 && complex_iszero(B->coef[db * n + i]); --db);
+        if (db == -1) {
+            return -1;  /* Division by zero */
+        }
+        db_min = MIN(db_min, db);
+        db_max = MAX(db_max, db);
+    }
+    if (!poly_array_init(Q, n, (n == 0) ? -1 : MAX(-1, A->deg - db_min))) {
+        return 0;
+    }
+    if (!poly_array_init(R, n, MIN(A->deg, db_max - 1))) {
+        poly_array_free(Q);
+        return 0;
+    }
+    poly_arena_init(&arena, 2 * (A->deg + 1) + B->deg + 1);
+    if (n > 0
+            &&
+        (!poly_arena_poly(&arena, &a, A->deg) || !poly_arena_poly(&arena, &b, B->deg)
+            ||
+         !poly_arena_poly(&arena, &q, A->deg))) {
+        poly_arena_release(&arena);
+        poly_array_free(Q);
+        poly_array_free(R);
+        return 0;
+    }
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j <= A->deg; ++j) {
+            a.coef[j] = A->coef[j * n + i];
+        }
+        for (j = 0; j <= B->deg; ++j) {
+            b.coef[j] = B->coef[j * n + i];
+        }
+        a.deg = A->deg;
+        b.deg = B->deg;
+        Poly_ResizeDown(&a);
+        Poly_ResizeDown(&b);
+        _poly_divmod_inplace(&a, &b, &q);
+        for (j = 0; j <= q.deg; ++j) {
+            Q->coef[j * n + i] = q.coef[j];
+        }
+        for (j = 0; j <= a.deg; ++j) {
+            R->coef[j * n + i] = a.coef[j];
+        }
+    }
+    poly_arena_release(&arena);
+    _array_resize_down(Q);
+    _array_resize_down(R);
+    return 1;
+}
+
+/* The factors j (j - 1) ... (j - n + 1) are common to whole columns */
+int
+poly_array_derive(PolyArray *A, unsigned int n, PolyArray *R)
+{
+    int i, j, deg = (A->deg < 0 || n > (unsigned)A->deg) ? -1 : A->deg - (int)n;
+    const Complex *a;
+    Complex *f, *r;
+    PolyArena arena;
+    if (!_array_alloc(R, A->n, deg)) {
+        return 0;
+    }
+    if (deg < 0) {
+        return 1;
+    }
+    poly_arena_init(&arena, 0);
+    if ((f = poly_arena_alloc(&arena, deg + 1)) == NULL) {
+        poly_arena_release(&arena);
+        poly_array_free(R);
+        return 0;
+    }
+    /* f[j] = (j + 1) ... (j + n), as for poly_derive, infinite on overflow */
+    for (j = 0; j <= deg; ++j) {
+        f[j] = COne;
+    }
+    _scale_factorial_ratios(f, deg + 1, n, 0);
+    for (j = 0; j <= deg; ++j) {
+        a = A->coef + (j + (int)n) * A->n;
+        r = R->coef + j * A->n;
+        if (isfinite(f[j].real)) {
+            kernels->scale(r, a, f[j], A->n);
+            continue;
+        }
+        for (i = 0; i < A->n; ++i) {
+            r[i].real = (a[i].real == 0.) ? 0. : a[i].real * HUGE_VAL;
+            r[i].imag = (a[i].imag == 0.) ? 0. : a[i].imag * HUGE_VAL;
+        }
+    }
+    poly_arena_release(&arena);
+    _array_resize_down(R);
+    return 1;
+}
+
+/* y[i] = A[i](x[i]), by Horner's method with one lane per polynomial */
+void
+poly_array_eval(PolyArray *A, const Complex *x, Complex *y)
+{
+    kernels->horner_lanes(A->coef, A->deg, A->n, x, 1, y, A->n);
+}
+
+/* y[i] = A[i](x) */
+void
+poly_array_eval_all(PolyArray *A, Complex x, Complex *y)
+{
+    kernels->horner_lanes(A->coef, A->deg, A->n, &x, 0, y, A->n);
 }
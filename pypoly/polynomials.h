@@ -1,6 +1,7 @@
 #ifndef POLYNOMIALS_H
 #define POLYNOMIALS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifndef PYPOLY_VERSION
@@ -17,13 +18,103 @@ typedef struct {
  * A Polynomial is represented as a basic array.
  * Since a Complex generally takes 8 bytes of memory, the coefficients will take
  * (1 + degree) * 8 bytes of memory. This shouldn't be a problem in common
- * use cases. */
+ * use cases.
+ * The array may hold more than (1 + degree) coefficients: "capacity" is the
+ * number of allocated coefficients, so that a growing Polynomial does not
+ * need to be reallocated every time its degree increases.
+ * Copies share the same array until one of them is modified: functions
+ * modifying a Polynomial in place must call poly_make_writable first.
+ * Copies may be used from different threads, but a given Polynomial must
+ * not be modified while another thread reads it. */
 typedef struct {
     Complex* coef;
     int deg;
+    int capacity;
     uint32_t bloom;
+    int flags;
 } Polynomial;
 
+/* Polynomial flags */
+#define POLY_BORROWED   0x1     /* Coefficients are not owned (e.g. arena) */
+#define POLY_PINNED     0x2     /* Coefficients are exposed (e.g. buffer views):
+                                 * they are never shared with copies */
+
+/* Memory allocation of the coefficients arrays.
+ * Small arrays are served from per-thread pools of power-of-two sized blocks,
+ * released when the thread exits; larger ones go straight to the allocator,
+ * which defaults to the C library and can be replaced by embedders (e.g. to
+ * route through the Python memory manager or their own arena).
+ * The allocator must be thread-safe, as pools are released from exiting
+ * threads. It must be set before any Polynomial is created: afterwards
+ * poly_set_allocator returns 0 and leaves it unchanged. */
+typedef struct {
+    void *ctx;
+    void* (*malloc)(void *ctx, size_t size);
+    void* (*realloc)(void *ctx, void *ptr, size_t size);
+    void (*free)(void *ctx, void *ptr);
+} PolyAllocator;
+
+void poly_get_allocator(PolyAllocator *allocator);
+
+int poly_set_allocator(const PolyAllocator *allocator);
+
+/* Allocation counters of the calling thread. */
+typedef struct {
+    size_t allocs;          /* Coefficients arrays handed out */
+    size_t frees;           /* Coefficients arrays given back */
+    size_t pool_hits;       /* Allocations served by the pools */
+    size_t system_allocs;   /* Calls to the allocator malloc / realloc */
+    size_t system_frees;    /* Calls to the allocator free */
+} PolyAllocStats;
+
+void poly_get_alloc_stats(PolyAllocStats *stats);
+
+void poly_reset_alloc_stats(void);
+
+void poly_clear_pools(void);
+
+/* Scratch arena.
+ * Composite algorithms draw the coefficients of their temporaries from a
+ * bump-pointer arena, and release them all at once when done.
+ * Polynomials initialized with poly_arena_poly are flagged POLY_BORROWED:
+ * poly_free does not release their coefficients, and growing them moves the
+ * coefficients to regular storage. They must not outlive the arena. */
+typedef struct PolyArenaChunk PolyArenaChunk;
+
+typedef struct {
+    PolyArenaChunk *chunk;  /* Current chunk, chained to the previous ones */
+    int hint;               /* Minimal size of the first chunk */
+} PolyArena;
+
+typedef struct {
+    PolyArenaChunk *chunk;
+    int used;
+} PolyArenaMark;
+
+void poly_arena_init(PolyArena *arena, int hint);
+
+Complex* poly_arena_alloc(PolyArena *arena, int n);
+
+int poly_arena_poly(PolyArena *arena, Polynomial *P, int deg);
+
+PolyArenaMark poly_arena_mark(PolyArena *arena);
+
+void poly_arena_rewind(PolyArena *arena, PolyArenaMark mark);
+
+void poly_arena_release(PolyArena *arena);
+
+/* Runtime CPU dispatch of the core kernels */
+#define POLY_CPU_AVX2       0x1
+#define POLY_CPU_FMA        0x2
+#define POLY_CPU_AVX512F    0x4
+#define POLY_CPU_AVX512VL   0x8
+
+int poly_cpu_init(const char *name);
+
+unsigned int poly_cpu_features(void);
+
+const char* poly_kernels_name(void);
+
 int poly_init(Polynomial *P, int deg);
 
 void poly_free(Polynomial *P);
@@ -38,6 +129,22 @@ void poly_set_coef(Polynomial *P, int i, Complex c);
 
 int poly_realloc(Polynomial *P, int deg);
 
+int poly_reserve(Polynomial *P, int capacity);
+
+int poly_shrink_to_fit(Polynomial *P);
+
+int poly_make_writable(Polynomial *P);
+
+void poly_normalize(Polynomial *P);
+
+void poly_borrow(Polynomial *P, Complex *coef, int n);
+
+int poly_pin(Polynomial *P);
+
+void poly_unpin(Polynomial *P);
+
+void poly_sync(Polynomial *P, int n);
+
 Complex poly_eval(Polynomial *P, Complex c);
 
 int poly_add(Polynomial *A, Polynomial *B, Polynomial *R);
@@ -50,6 +157,35 @@ int poly_scal_multiply(Polynomial *A, Complex c, Polynomial *R);
 
 int poly_multiply(Polynomial *A, Polynomial *B, Polynomial *R);
 
+/* Truncated products: only the requested coefficients of A * B are computed.
+ * "algorithm" is one of the following, POLY_MUL_AUTO picks the fastest one
+ * for the size of the operands. */
+#define POLY_MUL_AUTO           0
+#define POLY_MUL_SCHOOLBOOK     1
+#define POLY_MUL_KARATSUBA      2
+#define POLY_MUL_FFT            3
+
+int poly_mul_low(Polynomial *A, Polynomial *B, int n, int algorithm,
+                 Polynomial *R);
+
+int poly_mul_high(Polynomial *A, Polynomial *B, int n, int algorithm,
+                  Polynomial *R);
+
+int poly_mul_middle(Polynomial *A, Polynomial *B, int lo, int hi,
+                    int algorithm, Polynomial *R);
+
+/* Sums of products c_1 A_1 B_1 + ... + c_n A_n B_n, accumulated into a
+ * single result. B may be NULL for a term c A. */
+typedef struct {
+    Complex c;
+    Polynomial *A;
+    Polynomial *B;
+} PolyTerm;
+
+int poly_sum_of_products(const PolyTerm *terms, int n, Polynomial *R);
+
+int poly_fma(Polynomial *A, Polynomial *B, Polynomial *C, Polynomial *R);
+
 int poly_pow(Polynomial *A, unsigned int n, Polynomial *R);
 
 int poly_derive(Polynomial *A, unsigned int n, Polynomial *R);
@@ -60,6 +196,117 @@ int poly_div(Polynomial *A, Polynomial *B, Polynomial *Q, Polynomial *R);
 
 int poly_gcd(Polynomial *A, Polynomial *B, Polynomial *P);
 
+int poly_compose(Polynomial *P, Polynomial *Q, Polynomial *R);
+
+int poly_compose_mod(Polynomial *P, Polynomial *Q, Polynomial *M, Polynomial *R);
+
+int poly_shift(Polynomial *P, Complex a, Polynomial *R);
+
+int poly_scale(Polynomial *P, Complex a, Polynomial *R);
+
+int poly_eval_matrix(Polynomial *P, const Complex *A, int n, Complex *R);
+
+/* Power series: A is taken as a power series and the result is computed
+ * modulo X**n. These return -1 if the result is not a power series. */
+
+int poly_valuation(Polynomial *P);
+
+void poly_truncate(Polynomial *P, int n);
+
+int poly_series_inverse(Polynomial *A, int n, Polynomial *R);
+
+int poly_series_log(Polynomial *A, int n, Polynomial *R);
+
+int poly_series_exp(Polynomial *A, int n, Polynomial *R);
+
+int poly_series_sqrt(Polynomial *A, int n, Polynomial *R);
+
+int poly_series_pow(Polynomial *A, Complex e, int n, Polynomial *R);
+
+/* Classical orthogonal polynomials of degree n: Chebyshev polynomials of
+ * the first kind T_n, Legendre polynomials P_n and (probabilists') Hermite
+ * polynomials He_n, for n >= 0. */
+
+int poly_chebyshev(int n, Polynomial *R);
+
+int poly_legendre(int n, Polynomial *R);
+
+int poly_hermite(int n, Polynomial *R);
+
+/* Chebyshev series: polynomials whose coefficient i is that of the Chebyshev
+ * polynomial T_i rather than X**i. Sums, differences and scalar products are
+ * those of polynomials. */
+
+char* poly_cheb_to_string(Polynomial *C);
+
+Complex poly_cheb_eval(Polynomial *C, Complex x);
+
+void poly_cheb_eval_many(Polynomial *C, const Complex *x, Complex *y, int m);
+
+int poly_cheb_multiply(Polynomial *A, Polynomial *B, Polynomial *R);
+
+int poly_cheb_from_poly(Polynomial *P, Polynomial *R);
+
+int poly_cheb_to_poly(Polynomial *C, Polynomial *R);
+
+/* In-place variants: the first operand is both a parameter and the
+ * destination, and its coefficients storage is reused (grown if needed). */
+
+int poly_iadd(Polynomial *A, Polynomial *B);
+
+int poly_isub(Polynomial *A, Polynomial *B);
+
+int poly_imultiply(Polynomial *A, Polynomial *B);
+
+int poly_iaddmul(Polynomial *A, Polynomial *B, Polynomial *C);
+
+int poly_iderive(Polynomial *A, unsigned int n);
+
+int poly_iintegrate(Polynomial *A, unsigned int n);
+
+/* Arrays of polynomials: a batch of n polynomials of degree at most "deg",
+ * stored as a (deg + 1) x n matrix in column major order. The coefficient j
+ * of every polynomial is at coef[j * n ... j * n + n - 1], so that the
+ * elementwise operations run each loop across the whole batch (structure of
+ * arrays). The higher coefficients of the polynomials of lower degree are
+ * zero. */
+typedef struct {
+    Complex *coef;
+    int n;
+    int deg;
+    int capacity;
+} PolyArray;
+
+int poly_array_init(PolyArray *A, int n, int deg);
+
+void poly_array_free(PolyArray *A);
+
+int poly_array_realloc(PolyArray *A, int deg);
+
+int poly_array_get(PolyArray *A, int i, Polynomial *P);
+
+void poly_array_set(PolyArray *A, int i, Polynomial *P);
+
+int poly_array_equal(PolyArray *A, PolyArray *B);
+
+/* The operands of the elementwise operations must have the same length */
+
+int poly_array_add(PolyArray *A, PolyArray *B, PolyArray *R);
+
+int poly_array_sub(PolyArray *A, PolyArray *B, PolyArray *R);
+
+int poly_array_scale(PolyArray *A, Complex c, PolyArray *R);
+
+int poly_array_multiply(PolyArray *A, PolyArray *B, PolyArray *R);
+
+int poly_array_div(PolyArray *A, PolyArray *B, PolyArray *Q, PolyArray *R);
+
+int poly_array_derive(PolyArray *A, unsigned int n, PolyArray *R);
+
+void poly_array_eval(PolyArray *A, const Complex *x, Complex *y);
+
+void poly_array_eval_all(PolyArray *A, Complex x, Complex *y);
+
 /* Common Macros / inline helpers */
 
 /* Check if a complex number equals (0,0).
@@ -0,0 +1,184 @@
+import array
+import random
+import unittest
+
+from pypoly import Polynomial, PolynomialArray, X
+
+
+def unpack(buf):
+    a = array.array('d', bytes(buf))
+    return [complex(a[2 * i], a[2 * i + 1]) for i in range(len(a) // 2)]
+
+
+def random_polys(n, deg, seed):
+    rng = random.Random(seed)
+    return [Polynomial(*[complex(rng.randint(-9, 9), rng.randint(-9, 9))
+                         for _ in range(rng.randint(0, deg + 1))])
+            for _ in range(n)]
+
+
+class ConstructionTestCase(unittest.TestCase):
+    def test_items(self):
+        A = PolynomialArray([1 + X, X**3, 2])
+        self.assertEqual(len(A), 3)
+        self.assertEqual(A.degree, 3)
+        self.assertEqual(list(A), [1 + X, X**3, Polynomial(2)])
+        self.assertEqual(A[-1], Polynomial(2))
+
+    def test_empty(self):
+        A = PolynomialArray([])
+        self.assertEqual(len(A), 0)
+        self.assertEqual(A.degree, -1)
+        self.assertEqual(list(A + A), [])
+
+    def test_zeros(self):
+        A = PolynomialArray.zeros(4, 2)
+        self.assertEqual(A.degree, 2)
+        self.assertEqual(list(A), [Polynomial()] * 4)
+
+    def test_repr(self):
+        self.assertEqual(repr(PolynomialArray([1 + X, 0])),
+                         "PolynomialArray([1 + X, 0])")
+
+    def test_setitem(self):
+        A = PolynomialArray([1 + X, X])
+        A[0] = 3
+        A[1] = X**4
+        self.assertEqual(A.degree, 4)
+        self.assertEqual(list(A), [Polynomial(3), X**4])
+
+    def test_errors(self):
+        with self.assertRaises(TypeError):
+            PolynomialArray([X, "X"])
+        with self.assertRaises(TypeError):
+            PolynomialArray(X)
+        with self.assertRaises(IndexError):
+            PolynomialArray([X])[1]
+        with self.assertRaises(ValueError):
+            PolynomialArray.zeros(-1, 2)
+
+
+class ArithmeticTestCase(unittest.TestCase):
+    P = random_polys(600, 16, 1)
+    Q = random_polys(600, 16, 2)
+
+    def test_add_sub(self):
+        A, B = PolynomialArray(self.P), PolynomialArray(self.Q)
+        self.assertEqual(list(A + B), [p + q for p, q in zip(self.P, self.Q)])
+        self.assertEqual(list(A - B), [p - q for p, q in zip(self.P, self.Q)])
+        self.assertEqual(list(B - A), [q - p for p, q in zip(self.P, self.Q)])
+
+    def test_degrees(self):
+        A = PolynomialArray([1 + X**3, X])
+        self.assertEqual((A - A).degree, -1)
+        self.assertEqual((A + PolynomialArray([-X**3, 1])).degree, 1)
+
+    def test_multiply(self):
+        A, B = PolynomialArray(self.P), PolynomialArray(self.Q)
+        self.assertEqual(list(A * B), [p * q for p, q in zip(self.P, self.Q)])
+
+    def test_scale(self):
+        A = PolynomialArray(self.P)
+        self.assertEqual(list(2j * A), [2j * p for p in self.P])
+        self.assertEqual(list(A * 0), [Polynomial()] * len(self.P))
+        self.assertEqual(list(-A), [-p for p in self.P])
+        self.assertEqual(+A, A)
+
+    def test_divmod(self):
+        divisors = [q if q.degree >= 0 else Polynomial(1) for q in self.Q]
+        Q, R = divmod(PolynomialArray(self.P), PolynomialArray(divisors))
+        for p, d, q, r in zip(self.P, divisors, Q, R):
+            self.assertTrue(r.degree < d.degree)
+            E = q * d + r - p
+            for i in range(p.degree + 1):
+                self.assertAlmostEqual(E[i], 0, places=6)
+
+    def test_divide_by_zero(self):
+        with self.assertRaises(ZeroDivisionError):
+            divmod(PolynomialArray([X, X]), PolynomialArray([1, 0]))
+
+    def test_length_mismatch(self):
+        with self.assertRaises(ValueError):
+            PolynomialArray([X]) + PolynomialArray([X, X])
+
+    def test_unsupported(self):
+        with self.assertRaises(TypeError):
+            PolynomialArray([X]) + X
+
+    def test_compare(self):
+        self.assertEqual(PolynomialArray([X, 1]), PolynomialArray([X, 1]))
+        self.assertNotEqual(PolynomialArray([X, 1]), PolynomialArray([X, 1 + X]))
+        self.assertNotEqual(PolynomialArray([X]), PolynomialArray([X, X]))
+
+
+class CalculusTestCase(unittest.TestCase):
+    P = random_polys(300, 12, 3)
+
+    def test_derive(self):
+        A = PolynomialArray(self.P)
+        self.assertEqual(list(A.derive()), [p >> 1 for p in self.P])
+        self.assertEqual(list(A.derive(3)), [p >> 3 for p in self.P])
+        self.assertEqual(A.derive(13).degree, -1)
+
+    def test_derive_overflow(self):
+        P = Polynomial(*[float(i % 3 != 1) for i in range(300)])
+        A = PolynomialArray([P, X**299, 0])
+        for n in (150, 200, 290):
+            D = A.derive(n)
+            self.assertEqual(list(D), [P >> n, X**299 >> n, Polynomial()])
+            self.assertFalse(any(c != c for c in (D[0][i] for i in range(D.degree + 1))))
+
+    def test_eval(self):
+        points = [0.5 * i - 1j for i in range(len(self.P))]
+        raw = array.array('d', [v for z in points for v in (z.real, z.imag)])
+        values = unpack(PolynomialArray(self.P).eval(raw.tobytes()))
+        for p, x, y in zip(self.P, points, values):
+            self.assertAlmostEqual(y, p(x), delta=1e-12 * max(1, abs(y)))
+
+    def test_eval_all(self):
+        for x in (0, 0.75, 1 - 0.5j):
+            values = unpack(PolynomialArray(self.P).eval_all(x))
+            self.assertEqual(len(values), len(self.P))
+            for p, y in zip(self.P, values):
+                self.assertAlmostEqual(y, p(x), delta=1e-12 * max(1, abs(y)))
+
+    def test_eval_all_short(self):
+        A = PolynomialArray([1 + X, X**2, 3])
+        self.assertEqual(unpack(A.eval_all(2)), [3, 4, 3])
+        self.assertEqual(unpack(PolynomialArray([]).eval_all(1)), [])
+        self.assertEqual(unpack(PolynomialArray.zeros(2, -1).eval_all(1)), [0, 0])
+
+    def test_eval_size(self):
+        with self.assertRaises(ValueError):
+            PolynomialArray([X, X]).eval(array.array('d', [1.]))
+
+
+class BufferTestCase(unittest.TestCase):
+    def test_layout(self):
+        A = PolynomialArray([1 + 2 * X, 3j * X])
+        view = memoryview(A)
+        self.assertEqual(view.format, 'Zd')
+        self.assertEqual(view.shape, (2, 2))
+        self.assertEqual(view.strides, (16, 32))
+        self.assertEqual(unpack(view.tobytes(order='A')), [1, 0, 2, 3j])
+        self.assertEqual(unpack(bytes(A)), [1, 2, 0, 3j])
+
+    def test_write(self):
+        A = PolynomialArray.zeros(1, 1)
+        view = memoryview(A).cast('B')
+        view[16:32] = array.array('d', [5., 1.]).tobytes()
+        self.assertEqual(A[0], (5 + 1j) * X)
+
+    def test_exports_block_resize(self):
+        A = PolynomialArray([X, 1])
+        view = memoryview(A)
+        A[1] = 2 * X
+        with self.assertRaises(BufferError):
+            A[1] = X**2
+        view.release()
+        A[1] = X**2
+        self.assertEqual(A.degree, 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,3 +1,4 @@
+import array
 import unittest
 import sys
 
@@ -21,5 +22,214 @@ class DegreeTestCase(unittest.TestCase):
         with self.assertRaises(Exc):
             X.degree = 3
 
+class CapacityTestCase(unittest.TestCase):
+    def test_zero(self):
+        self.assertEqual(Polynomial().capacity, 0)
+
+    def test_polynomial(self):
+        # Small coefficients arrays (plus a header) are rounded up to a power of two
+        self.assertEqual(Polynomial(1, 2, 3).capacity, 3)
+        self.assertEqual(Polynomial(1, 2, 3, 4).capacity, 7)
+
+    def test_readonly(self):
+        Exc = AttributeError if sys.version_info[0] >= 3 else TypeError
+        with self.assertRaises(Exc):
+            X.capacity = 3
+
+    def test_reserve(self):
+        P = Polynomial(1, 2)
+        P.reserve(100)
+        self.assertEqual(P.capacity, 127)
+        self.assertEqual(P, Polynomial(1, 2))
+        P.reserve(10)
+        self.assertEqual(P.capacity, 127)
+
+    def test_reserve_large(self):
+        P = Polynomial(1, 2)
+        P.reserve(10000)
+        self.assertEqual(P.capacity, 10000)
+
+    def test_reserve_negative(self):
+        with self.assertRaises(ValueError):
+            Polynomial(1).reserve(-1)
+
+    def test_shrink_to_fit(self):
+        P = Polynomial(1, 2)
+        P.reserve(100)
+        P.shrink_to_fit()
+        self.assertEqual(P.capacity, 3)
+        self.assertEqual(P, Polynomial(1, 2))
+
+    def test_shrink_to_fit_zero(self):
+        P = Polynomial(1)
+        P[0] = 0
+        P.shrink_to_fit()
+        self.assertEqual(P.capacity, 0)
+        P[3] = 1
+        self.assertEqual(P, X**3)
+
+    def test_amortized_growth(self):
+        P = Polynomial()
+        capacities = set()
+        for i in range(1000):
+            P[i] = i + 1
+            capacities.add(P.capacity)
+        self.assertEqual(P, Polynomial(*range(1, 1001)))
+        self.assertTrue(len(capacities) < 20)
+
+class BufferTestCase(unittest.TestCase):
+    def test_layout(self):
+        view = memoryview(1 + 2j * X)
+        self.assertEqual(view.format, 'Zd')
+        self.assertEqual(view.itemsize, 16)
+        self.assertEqual(view.shape, (2,))
+        self.assertEqual(array.array('d', view.tobytes()).tolist(), [1, 0, 0, 2])
+        self.assertEqual(len(memoryview(Polynomial()).tobytes()), 0)
+
+    def test_write(self):
+        P = Polynomial(1, 2, 3)
+        with memoryview(P) as view:
+            raw = view.cast('B')
+            raw[16:32] = array.array('d', [0., 5.]).tobytes()
+            raw[32:48] = bytes(16)
+            self.assertEqual(P[1], 5j)
+            raw.release()
+        self.assertEqual(P, 1 + 5j * X)
+        self.assertEqual(P.degree, 1)
+
+    def test_copies(self):
+        P = 1 + X
+        Q = +P
+        with memoryview(P) as view:
+            R = +P
+            view.cast('B')[:8] = array.array('d', [7.]).tobytes()
+        self.assertEqual(P, 7 + X)
+        self.assertEqual(Q, 1 + X)
+        self.assertEqual(R, 1 + X)
+
+    def test_exports_block_resize(self):
+        P = Polynomial(1, 2)
+        P.reserve(10)
+        view = memoryview(P)
+        P[1] = 3
+        with self.assertRaises(BufferError):
+            P[2] = 1
+        with self.assertRaises(BufferError):
+            P.addmul(X, X)
+        with self.assertRaises(BufferError):
+            P.shrink_to_fit()
+        with self.assertRaises(BufferError):
+            P.reserve(100)
+        P.addmul(2, X)
+        self.assertEqual(P, 1 + 5 * X)
+        view.release()
+        P[2] = 1
+        self.assertEqual(P, 1 + 5 * X + X**2)
+
+    def test_arithmetic_on_live_view(self):
+        Q = X**2 + X + 1
+        view = memoryview(Q).cast('B')
+        view[32:48] = bytearray(16)
+        self.assertEqual(Q.degree, 1)
+        self.assertEqual(Q, 1 + X)
+        self.assertEqual(X**3 % Q, Polynomial(-1))
+        self.assertEqual(divmod(X**3, Q), (1 - X + X**2, Polynomial(-1)))
+        view[32:40] = array.array('d', [2.]).tobytes()
+        self.assertEqual(Q[2], 2)
+        self.assertEqual(Q(1), 4)
+        Q[2] = 0
+        view[32:40] = array.array('d', [3.]).tobytes()
+        Q[1] = 5
+        self.assertEqual(Q, 1 + 5 * X + 3 * X**2)
+        view.release()
+        self.assertEqual(Q, 1 + 5 * X + 3 * X**2)
+
+    def test_write_above_degree(self):
+        P = Polynomial(1, 2, 3)
+        view = memoryview(P)
+        P[2] = 0
+        self.assertEqual(P.degree, 1)
+        view.cast('B')[32:40] = array.array('d', [5.]).tobytes()
+        view.release()
+        self.assertEqual(P, 1 + 2 * X + 5 * X**2)
+
+
+class FromBufferTestCase(unittest.TestCase):
+    def test_share(self):
+        raw = bytearray(array.array('d', [1., 0., 0., 2., 0., 0.]).tobytes())
+        P = Polynomial.from_buffer(raw)
+        self.assertEqual(P, 1 + 2j * X)
+        P[0] = 5
+        self.assertEqual(array.array('d', bytes(raw))[0], 5.)
+
+    def test_copy(self):
+        raw = bytearray(array.array('d', [1., 0., 0., 2.]).tobytes())
+        P = Polynomial.from_buffer(raw, copy=True)
+        P[0] = 5
+        self.assertEqual(array.array('d', bytes(raw))[0], 1.)
+        self.assertEqual(Polynomial.from_buffer(bytes(raw)), 1 + 2j * X)
+
+    def test_float64(self):
+        P = Polynomial.from_buffer(array.array('d', [1., 2., 0.]))
+        self.assertEqual(P, 1 + 2 * X)
+        self.assertEqual(Polynomial.from_buffer(array.array('d')).degree, -1)
+
+    def test_source_updates(self):
+        raw = bytearray(48)
+        P = Polynomial.from_buffer(raw)
+        self.assertEqual(P.degree, -1)
+        raw[16:24] = array.array('d', [5.]).tobytes()
+        self.assertEqual(P[1], 5)
+        self.assertEqual(P, 5 * X)
+        raw[32:40] = array.array('d', [1.]).tobytes()
+        self.assertEqual(divmod(X**3, P), (-5 + X, 25 * X))
+        raw[32:40] = bytearray(8)
+        self.assertEqual(divmod(X**3, P), (0.2 * X**2, Polynomial()))
+        Q = +P
+        raw[16:24] = bytearray(8)
+        self.assertEqual(P.degree, -1)
+        self.assertEqual(Q, 5 * X)
+
+    def test_grow_shared(self):
+        raw = bytearray(array.array('d', [1., 0.]).tobytes())
+        P = Polynomial.from_buffer(raw)
+        P[3] = 1
+        self.assertEqual(P, 1 + X**3)
+        self.assertEqual(array.array('d', bytes(raw)).tolist(), [1., 0.])
+
+    def test_errors(self):
+        with self.assertRaises(TypeError):
+            Polynomial.from_buffer([1., 2.])
+        with self.assertRaises(TypeError):
+            Polynomial.from_buffer(array.array('i', [1, 2]))
+
+
+class FromIterableTestCase(unittest.TestCase):
+    def test_sequences(self):
+        self.assertEqual(Polynomial.from_iterable([1., 2., 0.]), 1 + 2 * X)
+        self.assertEqual(Polynomial.from_iterable((1, 2j)), 1 + 2j * X)
+        self.assertEqual(Polynomial.from_iterable(x for x in range(3)), X + 2 * X**2)
+        self.assertEqual(Polynomial.from_iterable([]).degree, -1)
+
+    def test_errors(self):
+        with self.assertRaises(TypeError):
+            Polynomial.from_iterable([1., "X"])
+        with self.assertRaises(TypeError):
+            Polynomial.from_iterable(1)
+        with self.assertRaises(TypeError):
+            Polynomial.from_iterable(X)
+
+    def test_mutating_items(self):
+        class Evil(object):
+            def __complex__(self):
+                del L[:]
+                return 1j
+        L = [1.] * 4 + [Evil()] + [0.5] * 100000
+        P = Polynomial.from_iterable(L)
+        self.assertEqual(P.degree, 100004)
+        self.assertEqual(P[4], 1j)
+        self.assertEqual(L, [])
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,108 @@
+import array
+import unittest
+
+from pypoly import ChebyshevSeries, Polynomial, X, chebyshev
+
+
+def unpack(buf):
+    a = array.array('d', bytes(buf))
+    return [complex(a[2 * i], a[2 * i + 1]) for i in range(len(a) // 2)]
+
+
+class ConstructionTestCase(unittest.TestCase):
+    def test_coefficients(self):
+        S = ChebyshevSeries(1, 2, 3)
+        self.assertEqual(S.degree, 2)
+        self.assertEqual(S[1], 2)
+        self.assertEqual(S[5], 0)
+        self.assertEqual(ChebyshevSeries(1, 0, 0).degree, 0)
+
+    def test_repr(self):
+        self.assertEqual(repr(ChebyshevSeries(1, 2, 3)), "1 + 2 * T1 + 3 * T2")
+        self.assertEqual(repr(ChebyshevSeries()), "0")
+
+    def test_error_type(self):
+        with self.assertRaises(TypeError):
+            ChebyshevSeries({})
+
+
+class ArithmeticTestCase(unittest.TestCase):
+    def test_add(self):
+        self.assertEqual(ChebyshevSeries(1, 2) + 1, ChebyshevSeries(2, 2))
+        self.assertEqual(ChebyshevSeries(1, 2) - ChebyshevSeries(1, 2, 3),
+                         ChebyshevSeries(0, 0, -3))
+
+    def test_multiply(self):
+        # T_1**2 = (T_0 + T_2) / 2
+        self.assertEqual(ChebyshevSeries(0, 1) * ChebyshevSeries(0, 1),
+                         ChebyshevSeries(0.5, 0, 0.5))
+        self.assertEqual(2 * ChebyshevSeries(1, 2), ChebyshevSeries(2, 4))
+
+    def test_multiply_large(self):
+        # Both sides of the DCT threshold
+        for n in (20, 150, 700):
+            A = ChebyshevSeries(*[1. / (i + 1) for i in range(n)])
+            B = ChebyshevSeries(*[(-1)**i / (i + 2.) for i in range(n + 7)])
+            P = A * B
+            self.assertEqual(P.degree, 2 * n + 5)
+            for x in (-1, -0.3, 0.2, 1):
+                self.assertAlmostEqual(P(x), A(x) * B(x), places=9)
+
+    def test_polynomial_operand(self):
+        with self.assertRaises(TypeError):
+            ChebyshevSeries(1) + X
+        with self.assertRaises(TypeError):
+            X * ChebyshevSeries(1)
+
+
+class EvaluationTestCase(unittest.TestCase):
+    S = ChebyshevSeries(*[1. / (i + 1)**2 for i in range(50)])
+
+    def test_call(self):
+        self.assertEqual(ChebyshevSeries()(0.5), 0)
+        self.assertEqual(ChebyshevSeries(1, 2, 3)(1), 6)
+        self.assertAlmostEqual(ChebyshevSeries(0, 0, 0, 1)(0.5), chebyshev(3)(0.5))
+
+    def test_eval_many(self):
+        points = [-1, -0.7, 0, 0.1, 0.5, 1] * 7
+        values = unpack(self.S.eval_many(array.array('d', points)))
+        self.assertEqual(len(values), len(points))
+        for x, y in zip(points, values):
+            self.assertAlmostEqual(y, self.S(x), places=12)
+
+    def test_eval_many_complex(self):
+        points = [0.5j, 1 + 1j, -0.25]
+        raw = array.array('d', [v for z in points for v in (z.real, z.imag)]).tobytes()
+        for z, y in zip(points, unpack(self.S.eval_many(raw))):
+            self.assertAlmostEqual(y, self.S(z), places=12)
+
+    def test_eval_many_empty(self):
+        self.assertEqual(len(self.S.eval_many(b'')), 0)
+
+
+class ConversionTestCase(unittest.TestCase):
+    def test_to_polynomial(self):
+        self.assertEqual(ChebyshevSeries(1, 0, 1).to_polynomial(), 2 * X**2)
+        for n in (5, 40, 100):
+            S = ChebyshevSeries(*[0] * n + [1])
+            P, T = S.to_polynomial(), chebyshev(n)
+            for i in range(n + 1):
+                self.assertAlmostEqual(P[i] / T[n], T[i] / T[n])
+
+    def test_from_polynomial(self):
+        self.assertEqual(ChebyshevSeries.from_polynomial(2 * X**2), ChebyshevSeries(1, 0, 1))
+        self.assertEqual(ChebyshevSeries.from_polynomial(3), ChebyshevSeries(3))
+        P = Polynomial(*[(-1)**i / (i + 1.) for i in range(300)])
+        S = ChebyshevSeries.from_polynomial(P)
+        self.assertEqual(S.degree, 299)
+        for x in (-1, -0.5, 0.25, 1):
+            self.assertAlmostEqual(S(x), P(x), places=10)
+
+    def test_round_trip(self):
+        S = ChebyshevSeries(*[1. / (i + 1) for i in range(30)])
+        T = ChebyshevSeries.from_polynomial(S.to_polynomial())
+        for i in range(30):
+            self.assertAlmostEqual(S[i], T[i], places=5)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,6 +1,6 @@
 import unittest
 
-from pypoly import X
+from pypoly import X, chebyshev, chebyshev_iterator, legendre, hermite
 from pypoly.examples import *
 
 
@@ -38,5 +38,44 @@ class HermiteTestCase(unittest.TestCase):
     def test_hermite_5(self):
         self.assertEqual(Hermite(5), X**5 - 10 * X**3 + 15 * X)
 
+class IteratorTestCase(unittest.TestCase):
+    def test_iterators(self):
+        for iterator, func in ((ChebyshevIterator, Chebyshev),
+                               (LegendreIterator, Legendre),
+                               (HermiteIterator, Hermite)):
+            for n, P in zip(range(10), iterator()):
+                self.assertEqual(P, func(n))
+
+    def test_start(self):
+        it = chebyshev_iterator(3)
+        self.assertEqual(next(it), 4 * X**3 - 3 * X)
+        self.assertEqual(next(it), 8 * X**4 - 8 * X**2 + 1)
+
+    def test_error_negative(self):
+        for func in (chebyshev, legendre, hermite, chebyshev_iterator):
+            with self.assertRaises(ValueError):
+                func(-1)
+
+class RecurrenceTestCase(unittest.TestCase):
+    def assertPolyAlmostEqual(self, A, B):
+        self.assertEqual(A.degree, B.degree)
+        for i in range(A.degree + 1):
+            self.assertAlmostEqual(A[i] / max(1, abs(B[i])), B[i] / max(1, abs(B[i])))
+
+    def test_chebyshev(self):
+        n = 60
+        self.assertPolyAlmostEqual(chebyshev(n + 1), 2 * X * chebyshev(n) - chebyshev(n - 1))
+        self.assertAlmostEqual(chebyshev(7)(0.5), 0.5)
+
+    def test_legendre(self):
+        n = 60
+        self.assertPolyAlmostEqual((n + 1) * legendre(n + 1),
+                                   (2 * n + 1) * X * legendre(n) - n * legendre(n - 1))
+        self.assertAlmostEqual(legendre(20)(1), 1)
+
+    def test_hermite(self):
+        n = 60
+        self.assertPolyAlmostEqual(hermite(n + 1), X * hermite(n) - n * hermite(n - 1))
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,117 @@
+import unittest
+
+from pypoly import LazyPolynomial, Polynomial, X
+
+
+class ConstructionTestCase(unittest.TestCase):
+    def test_polynomial(self):
+        L = LazyPolynomial(1 + X)
+        self.assertEqual(L.evaluate(), 1 + X)
+        self.assertEqual((1 + X).lazy().evaluate(), 1 + X)
+
+    def test_number(self):
+        self.assertEqual(LazyPolynomial(2j).evaluate(), Polynomial(2j))
+
+    def test_error_type(self):
+        with self.assertRaises(TypeError):
+            LazyPolynomial("X")
+
+    def test_copy_on_write(self):
+        P = 1 + X
+        L = P.lazy() + 1
+        P[0] = 5
+        self.assertEqual(L, 2 + X)
+
+
+class OperatorsTestCase(unittest.TestCase):
+    A = Polynomial(*range(1, 100))
+    B = Polynomial(*[1. / (i + 1) for i in range(80)])
+
+    def test_sum(self):
+        L = X.lazy()
+        self.assertEqual(1 + L + L**2 + L**3 + L**15,
+                         1 + X + X**2 + X**3 + X**15)
+
+    def test_sub(self):
+        self.assertEqual(X.lazy() - X, 0)
+        self.assertEqual(3 - X.lazy(), 3 - X)
+
+    def test_scale(self):
+        L = self.A.lazy()
+        self.assertEqual(2 * L, 2 * self.A)
+        self.assertEqual(L / 2, self.A / 2)
+        self.assertEqual(-L, -self.A)
+        self.assertEqual(+L, self.A)
+        with self.assertRaises(ZeroDivisionError):
+            L / 0
+
+    def test_products(self):
+        A, B = self.A.lazy(), self.B.lazy()
+        E = 2 * A * B - A * X + B * B
+        P = 2 * self.A * self.B - self.A * X + self.B * self.B
+        for i in range(P.degree + 1):
+            self.assertAlmostEqual(E[i], P[i], delta=1e-12 * abs(P[i]))
+
+    def test_long_products(self):
+        A = Polynomial(*range(300))
+        B = Polynomial(*range(1, 200))
+        E = (A.lazy() * B + A).evaluate()
+        P = A * B + A
+        self.assertEqual(E.degree, P.degree)
+        for i in range(P.degree + 1):
+            self.assertAlmostEqual(E[i], P[i], delta=1e-9 * abs(P[i]))
+
+    def test_power(self):
+        self.assertEqual((X.lazy() + 1)**3, 1 + 3 * X + 3 * X**2 + X**3)
+
+    def test_shared(self):
+        S = X.lazy() + 1
+        self.assertEqual(S * S + S, 2 + 3 * X + X**2)
+
+    def test_cancellation(self):
+        E = X.lazy()**3 + X - X**3
+        self.assertEqual(E.degree, 1)
+
+    def test_long_sum(self):
+        E = X.lazy()
+        for i in range(100000):
+            E = E + 1
+        self.assertEqual(E, 100000 + X)
+
+    def test_unsupported(self):
+        with self.assertRaises(TypeError):
+            X.lazy() + "X"
+        with self.assertRaises(TypeError):
+            X.lazy() ** -1
+
+
+class EvaluationTestCase(unittest.TestCase):
+    E = X.lazy() * 2 + 1
+
+    def test_repr(self):
+        self.assertEqual(repr(self.E), "1 + 2 * X")
+
+    def test_getitem(self):
+        self.assertEqual(self.E[1], 2)
+        self.assertEqual(self.E[5], 0)
+
+    def test_call(self):
+        self.assertEqual(self.E(2), 5)
+        self.assertEqual(self.E(X**2), 1 + 2 * X**2)
+
+    def test_degree(self):
+        self.assertEqual(self.E.degree, 1)
+
+    def test_comparison(self):
+        self.assertTrue(self.E == 1 + 2 * X)
+        self.assertTrue(1 + 2 * X == self.E)
+        self.assertFalse(self.E != self.E)
+
+    def test_evaluate_copy(self):
+        P = self.E.evaluate()
+        P += X
+        self.assertEqual(self.E, 1 + 2 * X)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,5 +1,6 @@
 import unittest
 
+import pypoly
 from pypoly import *
 
 class PolyXTestCase(unittest.TestCase):
@@ -30,5 +31,119 @@ class GCDTestCase(unittest.TestCase):
             gcd((1 + X)**2 * (2 + X) * (4 + X), (1 + X) * (2 + X) * (3 + X)),
             (1 + X) * (2 + X))
 
+    def test_allocations(self):
+        """Temporaries are drawn from a single arena: the number of
+        allocations does not depend on the number of Euclidean steps."""
+        counts = []
+        for n in (5, 50):
+            A, B = X**n - 1, X**(n + 1) - 1
+            before = alloc_stats()
+            gcd(A, B)
+            counts.append(alloc_stats()['allocs'] - before['allocs'])
+        self.assertEqual(counts[0], counts[1])
+
+class SumTestCase(unittest.TestCase):
+    def test_empty(self):
+        self.assertEqual(pypoly.sum([]), Polynomial())
+
+    def test_polynomials(self):
+        Ps = [Polynomial(*range(n)) for n in range(1, 40)]
+        S = Polynomial()
+        for P in Ps:
+            S += P
+        self.assertEqual(pypoly.sum(Ps), S)
+        self.assertEqual(pypoly.sum(iter(Ps)), S)
+
+    def test_numbers(self):
+        self.assertEqual(pypoly.sum([X, 1, 2j, X**2]), 1 + 2j + X + X**2)
+
+    def test_cancellation(self):
+        self.assertEqual(pypoly.sum([1 + X**5, -X**5]).degree, 0)
+
+    def test_errors(self):
+        with self.assertRaises(TypeError):
+            pypoly.sum(1)
+        with self.assertRaises(TypeError):
+            pypoly.sum(X)
+        with self.assertRaises(TypeError):
+            pypoly.sum([X, "X"])
+
+class LinearCombinationTestCase(unittest.TestCase):
+    def test_values(self):
+        self.assertEqual(
+            linear_combination([2, -1j, 3], [1 + X, X**3, 4]),
+            14 + 2 * X - 1j * X**3)
+
+    def test_large(self):
+        Ps = [Polynomial(*range(n, 3 * n)) for n in range(50)]
+        S = Polynomial()
+        for i, P in enumerate(Ps):
+            S += (i - 2.5) * P
+        self.assertEqual(linear_combination([i - 2.5 for i in range(50)], Ps), S)
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            linear_combination([1, 2], [X])
+        with self.assertRaises(TypeError):
+            linear_combination([X], [X])
+        with self.assertRaises(TypeError):
+            linear_combination([1], [None])
+
+class AllocStatsTestCase(unittest.TestCase):
+    def test_keys(self):
+        self.assertEqual(
+            sorted(alloc_stats()),
+            ['allocs', 'frees', 'pool_hits', 'system_allocs', 'system_frees'])
+
+    def test_pool_reuse(self):
+        P, Q = 1 + X + X**2, 2 - X**3
+        for _ in range(10):
+            divmod(P * Q, Q)
+        before = alloc_stats()
+        for _ in range(100):
+            divmod(P * Q, Q)
+        after = alloc_stats()
+        self.assertTrue(after['allocs'] - before['allocs'] >= 100)
+        self.assertEqual(after['system_allocs'], before['system_allocs'])
+
+    def test_thread_exit(self):
+        tracemalloc = __import__('tracemalloc')
+        import threading
+        import time
+
+        def work():
+            polys = [Polynomial(*range(1, 401)) for _ in range(64)]
+            del polys
+
+        tracemalloc.start()
+        try:
+            before = tracemalloc.get_traced_memory()[0]
+            thread = threading.Thread(target=work)
+            thread.start()
+            thread.join()
+            # join() returns slightly before the system thread is gone
+            deadline = time.time() + 5
+            while True:
+                after = tracemalloc.get_traced_memory()[0]
+                if after - before < 64 * 1024 or time.time() > deadline:
+                    break
+                time.sleep(0.01)
+        finally:
+            tracemalloc.stop()
+        # Its pools would hold 32 arrays of 8 KiB
+        self.assertLess(after - before, 64 * 1024)
+
+class CPUFeaturesTestCase(unittest.TestCase):
+    def test_keys(self):
+        features = cpu_features()
+        self.assertEqual(sorted(features),
+                         ['avx2', 'avx512f', 'avx512vl', 'fma', 'kernels'])
+        self.assertIn(features['kernels'], ('generic', 'avx2', 'avx512'))
+
+    def test_kernels(self):
+        P = 1 + 2j * X - X**2
+        self.assertEqual(P * P, 1 + 4j * X - 6 * X**2 - 4j * X**3 + X**4)
+        self.assertEqual(P(2), -3 + 4j)
+
 if __name__ == '__main__':
     unittest.main()
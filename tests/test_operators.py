@@ -1,7 +1,11 @@
+import array
+import functools
+import math
+import operator
 import unittest
 import sys
 
-from pypoly import Polynomial, X
+from pypoly import Polynomial, X, alloc_stats
 
 class ComparisonTestCase(unittest.TestCase):
     def test_same_obj(self):
@@ -90,10 +94,124 @@ class MultiplicationTestCase(unittest.TestCase):
         self.assertEqual((1 + X + 2 * X**2) * (complex(-2, 1) * X - 2),
             -2 + complex(-4, 1) * X + (-6+1j) * X**2 + complex(-4, 2) * X**3)
 
+    def test_monomial(self):
+        P = Polynomial(*range(1, 100))
+        expected = Polynomial(*([0] * 7 + [2j * c for c in range(1, 100)]))
+        self.assertEqual(2j * X**7 * P, expected)
+        self.assertEqual(P * (2j * X**7), expected)
+        self.assertEqual(X * X, X**2)
+
+    def test_monomial_truncated(self):
+        P = Polynomial(*range(1, 100))
+        self.assertEqual((X**7).mul_middle(P, 5, 10), Polynomial(0, 0, 1, 2, 3))
+        self.assertEqual(P.mul_low(X**200, 50), 0)
+
+    def test_monomial_in_place(self):
+        P = Polynomial(*range(1, 40))
+        Q = +P
+        Q *= 3 * X**33
+        self.assertEqual(Q, 3 * X**33 * P)
+        M = 3 * X**33
+        M *= P
+        self.assertEqual(M, Q)
+        M = 1j * X**5
+        M *= M
+        self.assertEqual(M, -X**10)
+
     def test_error_incompatible(self):
         with self.assertRaises(TypeError):
             X * {}
 
+class TruncatedProductTestCase(unittest.TestCase):
+    A = Polynomial(*[(i * 7) % 11 - 5 for i in range(300)])
+    B = Polynomial(*[(i * 5) % 13 - 6j for i in range(200)])
+    algorithms = ('schoolbook', 'karatsuba', 'fft', 'auto')
+
+    def assertBand(self, R, lo, hi):
+        P = self.A * self.B
+        self.assertEqual(R.degree, min(hi, P.degree + 1) - lo - 1)
+        for i in range(lo, hi):
+            self.assertAlmostEqual(R[i - lo], P[i], delta=1e-9 * abs(P[i]) + 1e-6)
+
+    def test_low(self):
+        for algorithm in self.algorithms:
+            self.assertBand(self.A.mul_low(self.B, 250, algorithm), 0, 250)
+
+    def test_high(self):
+        for algorithm in self.algorithms:
+            self.assertBand(self.A.mul_high(self.B, 250, algorithm), 250, 499)
+
+    def test_middle(self):
+        for algorithm in self.algorithms:
+            self.assertBand(self.A.mul_middle(self.B, 199, 300, algorithm), 199, 300)
+
+    def test_exact(self):
+        P = self.A * self.B
+        self.assertEqual(self.A.mul_low(self.B, 100, 'karatsuba'),
+                         P.mul_low(1, 100))
+        self.assertEqual(self.A.mul_high(self.B, 100, 'schoolbook'),
+                         Polynomial(*[P[i] for i in range(100, 499)]))
+
+    def test_out_of_range(self):
+        self.assertEqual((1 + X).mul_low(1 - X, 0), Polynomial())
+        self.assertEqual((1 + X).mul_high(1 - X, 3), Polynomial())
+        self.assertEqual((1 + X).mul_middle(1 - X, 1, 10), -X)
+        self.assertEqual((1 + X).mul_low(2, 10), 2 + 2 * X)
+
+    def test_error(self):
+        with self.assertRaises(ValueError):
+            X.mul_low(X, -1)
+        with self.assertRaises(ValueError):
+            X.mul_low(X, 1, algorithm='toom')
+        with self.assertRaises(TypeError):
+            X.mul_low({}, 1)
+
+class MultiplyAddTestCase(unittest.TestCase):
+    A = Polynomial(*[(i * 7) % 11 - 5 for i in range(300)])
+    B = Polynomial(*[(i * 5) % 13 - 6j for i in range(200)])
+
+    def test_fma(self):
+        self.assertEqual(Polynomial.fma(1 + X, 1 - X, X**2), 1)
+        self.assertEqual(Polynomial.fma(2, X, 1), 1 + 2 * X)
+        self.assertEqual(Polynomial.fma(X**3, self.B, 0), X**3 * self.B)
+        self.assertEqual(Polynomial.fma(self.A, 0, self.B), self.B)
+
+    def test_fma_long(self):
+        R = Polynomial.fma(self.A, self.B, self.A)
+        P = self.A * self.B + self.A
+        self.assertEqual(R.degree, P.degree)
+        for i in range(P.degree + 1):
+            self.assertAlmostEqual(R[i], P[i], delta=1e-9 * abs(P[i]) + 1e-6)
+
+    def test_addmul(self):
+        P = Polynomial(1, 2)
+        Q = +P
+        P.addmul(1 + X, X)
+        self.assertEqual(P, 1 + 3 * X + X**2)
+        self.assertEqual(Q, Polynomial(1, 2))
+        P.addmul(-X, X)
+        self.assertEqual(P.degree, 1)
+
+    def test_addmul_accumulate(self):
+        P = Polynomial()
+        for i in range(5):
+            P.addmul(self.A, self.B)
+        Q = 5 * self.A * self.B
+        self.assertEqual(P.degree, Q.degree)
+        for i in range(Q.degree + 1):
+            self.assertAlmostEqual(P[i], Q[i], delta=1e-9 * abs(Q[i]) + 1e-6)
+
+    def test_addmul_aliasing(self):
+        P = 1 + X
+        P.addmul(P, P)
+        self.assertEqual(P, 2 + 3 * X + X**2)
+
+    def test_error(self):
+        with self.assertRaises(TypeError):
+            Polynomial.fma(X, X)
+        with self.assertRaises(TypeError):
+            (+X).addmul(X, "X")
+
 class DivisionTestCase(unittest.TestCase):
     def test_polynomials(self):
         self.assertEqual(X / 1j, - 1j * X)
@@ -117,9 +235,61 @@ class PowerTestCase(unittest.TestCase):
         funcname = 'assertRaisesRegex' if sys.version_info[0] >= 3 else 'assertRaisesRegexp'
         assertRaisesRegex = getattr(self, funcname)
         with assertRaisesRegex(ValueError,
-            """Polynomial exponentiation with exponents higher"""
-            """ than 1024 is not supported"""):
-            X**1025
+            """Polynomial exponentiation result would exceed"""
+            """ the memory budget"""):
+            X**(2**40)
+
+    def test_high_exponent(self):
+        P = (1 + X)**5000
+        self.assertEqual(P.degree, 5000)
+        self.assertEqual(P[0], 1)
+        self.assertEqual(P[1], 5000)
+        self.assertAlmostEqual(P[4999] / 5000, 1, places=12)
+        self.assertAlmostEqual(P[3] / (5000 * 4999 * 4998 / 6), 1, places=12)
+
+    def test_high_exponent_scaled(self):
+        # Most coefficients are out of the range of doubles
+        P = (0.5 + 0.3 * X + 0.2 * X**2)**5000
+        self.assertAlmostEqual(P(1), 1, places=9)
+        self.assertEqual(P[0], 0)   # Underflow
+        self.assertTrue(P[5000] > 0)
+
+    def test_sparse_base(self):
+        P = (2 - X**3)**20
+        Q = Polynomial(1)
+        for _ in range(20):
+            Q *= 2 - X**3
+        self.assertEqual(P, Q)
+
+    def assertBinomial(self, P, n, x):
+        # P should be (1 + x X)**n
+        self.assertEqual(P.degree, n)
+        c = 1
+        for k in range(n + 1):
+            self.assertAlmostEqual(P[k] / (c * x**k), 1, places=12)
+            c = c * (n - k) // (k + 1)
+
+    def test_alternating_base(self):
+        for n in (16, 30, 50, 100):
+            self.assertBinomial((1 - X)**(2 * n), 2 * n, -1)
+        self.assertBinomial((1 - 2 * X + X**2)**50, 100, -1)
+        self.assertBinomial((1 - 0.5j * X)**40, 40, -0.5j)
+
+    def test_mixed_signs_base(self):
+        P = (1 + X - X**2)**20
+        Q = Polynomial(1)
+        for _ in range(20):
+            Q *= 1 + X - X**2
+        for k in range(41):
+            self.assertAlmostEqual(P[k], Q[k], delta=1e-12 * max(1, abs(Q[k])))
+
+    def test_monomial(self):
+        P = (3 * X**2)**40
+        self.assertEqual(P.degree, 80)
+        self.assertAlmostEqual(P[80] / 3.**40, 1, places=12)
+        self.assertEqual(X**15, Polynomial(*([0] * 15 + [1])))
+        self.assertEqual((1j * X**3)**2, -X**6)
+        self.assertEqual((0.5 * X)**2000, 0)
 
     def test_error_neg(self):
         with self.assertRaises(TypeError):
@@ -143,6 +313,20 @@ class DivmodTestCase(unittest.TestCase):
         with self.assertRaises(ZeroDivisionError):
             X % 0
 
+    def test_lower_degree(self):
+        Q, R = divmod(1 + X, X**3)
+        self.assertEqual(Q, 0)
+        self.assertEqual(Q.degree, -1)
+        self.assertEqual(R, 1 + X)
+
+    def test_large_coefficients(self):
+        """Complex division must not overflow when squaring the divisor."""
+        self.assertEqual((1e300j * X**2) // (1e300j * X), X)
+
+    def test_exact(self):
+        P = (1 + X)**3 * (2 - X**2)
+        self.assertEqual(divmod(P, (1 + X)**3), (2 - X**2, 0))
+
 class SequenceTestCase(unittest.TestCase):
     def test_get_item(self):
         self.assertEqual((1 + 2 * X + 3 * X**2)[1], 2)
@@ -185,6 +369,141 @@ class CallTestCase(unittest.TestCase):
         with self.assertRaises(TypeError):
             Polynomial({})
 
+class MatrixEvaluationTestCase(unittest.TestCase):
+    @staticmethod
+    def unpack(buf, n):
+        a = array.array('d', bytes(buf))
+        return [[complex(a[2 * (i * n + j)], a[2 * (i * n + j) + 1])
+                 for j in range(n)] for i in range(n)]
+
+    @staticmethod
+    def horner(P, A, n):
+        R = [[0j] * n for _ in range(n)]
+        for d in range(P.degree, -1, -1):
+            R = [[sum(R[i][k] * A[k][j] for k in range(n)) for j in range(n)]
+                 for i in range(n)]
+            for i in range(n):
+                R[i][i] += P[d]
+        return R
+
+    def test_rotation(self):
+        # J**2 = -I
+        J = array.array('d', [0, 1, -1, 0])
+        self.assertEqual(self.unpack((1 + X**2).eval_matrix(J, 2), 2), [[0, 0], [0, 0]])
+        self.assertEqual(self.unpack(X.eval_matrix(J, 2), 2), [[0, 1], [-1, 0]])
+
+    def test_constant(self):
+        A = array.array('d', [1, 2, 3, 4])
+        self.assertEqual(self.unpack(Polynomial(3j).eval_matrix(A, 2), 2), [[3j, 0], [0, 3j]])
+        self.assertEqual(self.unpack(Polynomial().eval_matrix(A, 2), 2), [[0, 0], [0, 0]])
+        self.assertEqual(len(X.eval_matrix(b'', 0)), 0)
+
+    def test_horner(self):
+        n = 7
+        A = [[((i * 5 + j * 3) % 11 - 5) / 20. for j in range(n)] for i in range(n)]
+        real = array.array('d', [x for row in A for x in row])
+        cplx = array.array('d', [v for row in A for x in row for v in (x, 0.)]).tobytes()
+        for deg in (1, 2, 3, 10, 40):
+            P = Polynomial(*[1. / (i + 1) for i in range(deg + 1)])
+            E = self.horner(P, A, n)
+            for R in (self.unpack(P.eval_matrix(real, n), n),
+                      self.unpack(P.eval_matrix(cplx, n), n)):
+                for i in range(n):
+                    for j in range(n):
+                        self.assertAlmostEqual(R[i][j], E[i][j], places=12)
+
+    def test_error_buffer(self):
+        with self.assertRaises(ValueError):
+            X.eval_matrix(b'123', 2)
+        with self.assertRaises(ValueError):
+            X.eval_matrix(b'', -1)
+        with self.assertRaises(TypeError):
+            X.eval_matrix(array.array('f', [0] * 4), 2)
+        with self.assertRaises(TypeError):
+            X.eval_matrix(3, 1)
+
+class CompositionTestCase(unittest.TestCase):
+    @staticmethod
+    def horner(P, Q, M=None):
+        R = Polynomial()
+        for i in range(P.degree, -1, -1):
+            R = R * Q + P[i]
+            if M is not None:
+                R = R % M
+        return R
+
+    def assertPolyAlmostEqual(self, A, B):
+        self.assertEqual(A.degree, B.degree)
+        for i in range(A.degree + 1):
+            self.assertAlmostEqual(A[i], B[i], places=9)
+
+    def test_small(self):
+        self.assertEqual((1 + X**2).compose(X + 1), 2 + 2 * X + X**2)
+        self.assertEqual((1 + X**2)(X + 1), 2 + 2 * X + X**2)
+
+    def test_constant(self):
+        self.assertEqual((1 + X + X**2).compose(2), 7)
+        self.assertEqual((1 + X).compose(Polynomial()), 1)
+        self.assertEqual(Polynomial().compose(X + 1), 0)
+        self.assertEqual(Polynomial(3).compose(X + 1), 3)
+
+    def test_large(self):
+        P = Polynomial(*[(-1)**i / (i + 1.) for i in range(300)])
+        Q = Polynomial(0.5, 0.25j, -0.25)
+        self.assertPolyAlmostEqual(P.compose(Q), self.horner(P, Q))
+
+    def test_modulo(self):
+        P = Polynomial(*[1. / (i + 1) for i in range(200)])
+        Q = Polynomial(*[0.1j * (-1)**i for i in range(40)])
+        M = X**25 - 1
+        self.assertPolyAlmostEqual(P.compose(Q, mod=M), self.horner(P, Q, M))
+        P, Q = P % X**20, Q % X**4
+        self.assertPolyAlmostEqual(P.compose(Q, M), P.compose(Q) % M)
+
+    def test_modulo_constant(self):
+        self.assertEqual((X**2 + 1).compose(X, mod=3), 0)
+
+    def test_error_zero_modulo(self):
+        with self.assertRaises(ZeroDivisionError):
+            X.compose(X, mod=0)
+
+    def test_error_incompatible(self):
+        with self.assertRaises(TypeError):
+            X.compose({})
+        with self.assertRaises(TypeError):
+            X.compose(X, mod={})
+
+class ShiftTestCase(unittest.TestCase):
+    def test_small(self):
+        self.assertEqual((X**2).shift(1), 1 + 2 * X + X**2)
+        self.assertEqual((1 + X**3).shift(-1), Polynomial(0, 3, -3, 1))
+
+    def test_constant(self):
+        self.assertEqual(Polynomial(2).shift(5), 2)
+        self.assertEqual(Polynomial().shift(5), 0)
+        self.assertEqual((1 + X).shift(0), 1 + X)
+
+    def test_large(self):
+        # Both sides of the synthetic division threshold
+        for n in (40, 60, 300):
+            P = Polynomial(*[(-1)**i / (i + 1.) for i in range(n)])
+            S, T = P.shift(0.5j), P.compose(X + 0.5j)
+            for i in range(n):
+                self.assertAlmostEqual(S[i], T[i], places=9)
+
+    def test_evaluation(self):
+        P = Polynomial(*[1. / (i + 1) for i in range(100)])
+        self.assertAlmostEqual(P.shift(-0.25)(0.5), P(0.25), places=12)
+
+class ScaleTestCase(unittest.TestCase):
+    def test_scale(self):
+        self.assertEqual((1 + X + X**2).scale(2), 1 + 2 * X + 4 * X**2)
+        self.assertEqual((1 + X**2).scale(1j), 1 - X**2)
+
+    def test_zero(self):
+        self.assertEqual((3 + X**2).scale(0), 3)
+        self.assertEqual(Polynomial().scale(2), 0)
+
 class DerivationTestCase(unittest.TestCase):
     def test_derive_zero(self):
         self.assertEqual(Polynomial(0) >> 1, 0)
@@ -198,6 +517,24 @@ class DerivationTestCase(unittest.TestCase):
     def test_zero(self):
         self.assertEqual(Polynomial(1, 2, 3) >> 0, Polynomial(1, 2, 3))
 
+    def test_high_order(self):
+        # The multipliers exceed both int and the exact range of doubles
+        P = (X**40 + 3 * X**35) >> 30
+        self.assertEqual(P.degree, 10)
+        self.assertAlmostEqual(P[10] / (math.factorial(40) / math.factorial(10)), 1, places=14)
+        self.assertAlmostEqual(P[5] / (3 * math.factorial(35) / math.factorial(5)), 1, places=14)
+        self.assertEqual(P[4], 0)
+
+    def test_overflow(self):
+        P = (X**300 + X**200) >> 250
+        self.assertEqual(P, Polynomial(*[0] * 50, float("inf")))
+
+    def test_inplace(self):
+        P = Polynomial(*range(1, 100))
+        Q = P >> 7
+        P >>= 7
+        self.assertEqual(P, Q)
+
     def test_error_negative(self):
         with self.assertRaises(TypeError):
             X >> -1
@@ -215,9 +552,163 @@ class IntegrationTestCase(unittest.TestCase):
     def test_zero(self):
         self.assertEqual(Polynomial(1, 2, 3) << 0, Polynomial(1, 2, 3))
 
+    def test_high_order(self):
+        P = X**10 << 30
+        self.assertEqual(P.degree, 40)
+        self.assertAlmostEqual(P[40] * math.factorial(40) / math.factorial(10), 1, places=14)
+        self.assertEqual((P >> 30)[10], 1)
+
+    def test_underflow(self):
+        self.assertEqual(Polynomial(1) << 200, 0)
+
+    def test_inplace(self):
+        P = Polynomial(*range(1, 100))
+        Q = P << 7
+        P <<= 7
+        self.assertEqual(P, Q)
+
     def test_error_negative(self):
         with self.assertRaises(TypeError):
             X << -1
 
+class CopyOnWriteTestCase(unittest.TestCase):
+    def test_copy_shares(self):
+        P = Polynomial(*range(1, 100))
+        before = alloc_stats()
+        Q = +P
+        self.assertEqual(alloc_stats()['allocs'], before['allocs'])
+        self.assertEqual(P, Q)
+
+    def test_setitem_copy(self):
+        P = Polynomial(1, 2, 3)
+        Q = +P
+        Q[1] = 5
+        P[3] = 1
+        self.assertEqual(P, Polynomial(1, 2, 3, 1))
+        self.assertEqual(Q, Polynomial(1, 5, 3))
+
+    def test_inplace_copy(self):
+        P = Polynomial(1, 2, 3)
+        Q = +P
+        Q += X
+        Q >>= 1
+        P *= X
+        self.assertEqual(P, Polynomial(0, 1, 2, 3))
+        self.assertEqual(Q, Polynomial(3, 6))
+
+    def test_reserve_copy(self):
+        P = Polynomial(1, 2, 3)
+        Q = +P
+        Q.reserve(100)
+        Q[50] = 1
+        self.assertEqual(P, Polynomial(1, 2, 3))
+        self.assertEqual(P.capacity, 3)
+
+    def test_pow_one(self):
+        P = Polynomial(1, 2, 3)
+        Q = P**1
+        Q[0] = 0
+        self.assertEqual(P, Polynomial(1, 2, 3))
+
+class InPlaceTestCase(unittest.TestCase):
+    def test_add(self):
+        P = 1 + X
+        P += X**3
+        self.assertEqual(P, 1 + X + X**3)
+
+    def test_add_constant(self):
+        P = 1 + X
+        P += 2j
+        self.assertEqual(P, complex(1, 2) + X)
+
+    def test_sub(self):
+        P = 1 + X + X**2
+        P -= X**2
+        self.assertEqual(P, 1 + X)
+        self.assertEqual(P.degree, 1)
+
+    def test_mult(self):
+        P = 1 + X
+        P *= 2 - X
+        self.assertEqual(P, 2 + X - X**2)
+
+    def test_mult_self(self):
+        P = 1 + X
+        P *= P
+        self.assertEqual(P, 1 + 2 * X + X**2)
+
+    def test_mult_zero(self):
+        P = 1 + X
+        P *= 0
+        self.assertEqual(P, 0)
+        self.assertEqual(P.degree, -1)
+
+    def test_derive(self):
+        P = Polynomial(1, 2, 3)
+        P >>= 1
+        self.assertEqual(P, Polynomial(2, 6))
+
+    def test_integrate(self):
+        P = Polynomial(1, 2, 3)
+        P <<= 1
+        self.assertEqual(P, Polynomial(0, 1, 1, 1))
+
+    def test_reduce(self):
+        L = [1 + X, X, X**2]
+        self.assertEqual(functools.reduce(operator.iadd, L), 1 + 2 * X + X**2)
+        self.assertEqual(L, [1 + X, X, X**2])
+
+    def test_list_element(self):
+        L = [1 + X]
+        P = operator.iadd(L[0], X)
+        self.assertEqual(P, 1 + 2 * X)
+        self.assertEqual(L[0], 1 + X)
+
+    def test_tuple_element(self):
+        t = (1 + X,)
+        with self.assertRaises(TypeError):
+            t[0] += 1
+        self.assertEqual(t[0], 1 + X)
+
+    def test_shared_not_mutated(self):
+        P = 1 + X
+        Q = P
+        P += X
+        P *= X
+        P >>= 1
+        self.assertEqual(Q, 1 + X)
+        self.assertEqual(P, 1 + 4 * X)
+
+    def test_module_X_not_mutated(self):
+        P = X
+        P += 1
+        self.assertEqual(X, Polynomial(0, 1))
+
+    def test_accumulate(self):
+        acc = Polynomial()
+        for i in range(100):
+            acc += i * X**i
+        self.assertEqual(acc, Polynomial(*range(100)))
+
+    def test_error_incompatible(self):
+        P = 1 + X
+        with self.assertRaises(TypeError):
+            P += {}
+
+class TemporariesTestCase(unittest.TestCase):
+    """Temporaries are recycled through a freelist: make sure recycled
+    objects do not leak their previous state."""
+    def test_expression(self):
+        for _ in range(3):
+            self.assertEqual(
+                1 + X + X**2 + X**3 + X**15,
+                Polynomial(1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1))
+
+    def test_recycled_zero(self):
+        P = (1 + X)**3
+        del P
+        self.assertEqual(Polynomial().degree, -1)
+        self.assertEqual(Polynomial().capacity, 0)
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,104 @@
+import unittest
+
+from pypoly import Polynomial, PowerSeries, X
+
+
+def assertSeriesAlmostEqual(test, S, T, places=9):
+    test.assertEqual(S.precision, T.precision)
+    for i in range(S.precision):
+        test.assertAlmostEqual(S[i], T[i], places=places)
+
+
+class ConstructionTestCase(unittest.TestCase):
+    def test_truncated(self):
+        S = PowerSeries(1 + X + X**5, 3)
+        self.assertEqual(S.precision, 3)
+        self.assertEqual(S.polynomial, 1 + X)
+
+    def test_number(self):
+        self.assertEqual(PowerSeries(2, 4).polynomial, Polynomial(2))
+
+    def test_repr(self):
+        self.assertEqual(repr(PowerSeries(1 + X, 3)), "1 + X + O(X**3)")
+        self.assertEqual(repr(PowerSeries(0, 1)), "O(X)")
+
+    def test_getitem(self):
+        S = PowerSeries(1 + 2 * X, 3)
+        self.assertEqual(S[1], 2)
+        self.assertEqual(S[2], 0)
+        with self.assertRaises(IndexError):
+            S[3]
+
+    def test_error_negative_precision(self):
+        with self.assertRaises(ValueError):
+            PowerSeries(X, -1)
+
+
+class ArithmeticTestCase(unittest.TestCase):
+    def test_precision(self):
+        S = PowerSeries(1 + X, 5) + PowerSeries(X, 3)
+        self.assertEqual(S, PowerSeries(1 + 2 * X, 3))
+
+    def test_polynomial_operand(self):
+        self.assertEqual((1 + X**4) - PowerSeries(X, 3), PowerSeries(1 - X, 3))
+
+    def test_multiply(self):
+        S = PowerSeries(Polynomial(*range(1, 200)), 150)
+        P = S.polynomial * S.polynomial
+        self.assertEqual((S * S).polynomial,
+                         Polynomial(*[P[i] for i in range(150)]))
+
+    def test_divide(self):
+        S = PowerSeries(1, 6) / (1 - X)
+        self.assertEqual(S, PowerSeries(Polynomial(1, 1, 1, 1, 1, 1), 6))
+
+    def test_divide_by_zero(self):
+        with self.assertRaises(ZeroDivisionError):
+            PowerSeries(1, 3) / X
+
+    def test_integer_power(self):
+        self.assertEqual(PowerSeries(1 + X, 3)**3, PowerSeries(1 + 3 * X + 3 * X**2, 3))
+
+
+class FunctionsTestCase(unittest.TestCase):
+    S = PowerSeries(Polynomial(*[1. / (i + 1) for i in range(300)]), 300)
+
+    def test_inverse(self):
+        self.assertEqual(PowerSeries(1 - X, 5).inverse(),
+                         PowerSeries(1 + X + X**2 + X**3 + X**4, 5))
+        assertSeriesAlmostEqual(self, self.S * self.S.inverse(), PowerSeries(1, 300))
+
+    def test_log(self):
+        L = PowerSeries(1 + X, 5).log()
+        assertSeriesAlmostEqual(self, L, PowerSeries(Polynomial(0, 1, -1/2., 1/3., -1/4.), 5))
+
+    def test_exp_log(self):
+        assertSeriesAlmostEqual(self, self.S.log().exp(), self.S)
+
+    def test_exp(self):
+        E = PowerSeries(X, 5).exp()
+        assertSeriesAlmostEqual(self, E, PowerSeries(Polynomial(1, 1, 1/2., 1/6., 1/24.), 5))
+
+    def test_sqrt(self):
+        R = self.S.sqrt()
+        assertSeriesAlmostEqual(self, R * R, self.S)
+
+    def test_sqrt_valuation(self):
+        R = PowerSeries(X**2 + X**3, 6).sqrt()
+        self.assertEqual(R.precision, 5)
+        assertSeriesAlmostEqual(self, R * R, PowerSeries(X**2 + X**3, 6))
+        with self.assertRaises(ValueError):
+            PowerSeries(X, 6).sqrt()
+
+    def test_real_power(self):
+        R = PowerSeries(4 + X, 10)**1.5
+        assertSeriesAlmostEqual(self, R * R, PowerSeries(4 + X, 10)**3)
+        with self.assertRaises(ValueError):
+            PowerSeries(X, 3)**0.5
+
+    def test_complex(self):
+        S = PowerSeries(2j + X, 8)
+        assertSeriesAlmostEqual(self, S.log().exp(), S)
+
+if __name__ == '__main__':
+    unittest.main()